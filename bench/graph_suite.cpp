@@ -0,0 +1,438 @@
+/**
+ * @file graph_suite.cpp
+ * @author Jacek Falkowski
+ * @brief File contains a benchmark of loading, traversals and spanning trees on synthetic graphs with JSON output
+ */
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <getopt.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../include/graph.h"
+#include "../include/csr_graph.h"
+#include "../include/graph_snapshot.h"
+#include "../include/generators.h"
+#include "../include/bfs.h"
+#include "../include/dfs.h"
+#include "../include/spanning_tree.h"
+
+std::string help =
+R"(Measure loading, breadth-first search, depth-first search and maximum spanning tree on synthetic graphs
+Usage: graph_suite [OPTION]...
+Program options:
+--generator -g=<val>:        rmat, er, grid, path, star or all, all by default.
+--scale -n=<val>:            logarithm of a number of vertices, 16 by default.
+--degree -d=<val>:           average number of edges per vertex of rmat and er graphs, 16 by default.
+--seed -s=<val>:             seed of generated graphs, 1 by default.
+--repeat -r=<val>:           number of runs of every step, the median is reported, 3 by default.
+--graph-file -f=<val>:       temporary text file used to measure loading, bench_graph.txt by default.
+--output -o=<val>:           output file of JSON results, standard output by default.
+--help -h:                   show help
+)";
+
+//! results of a benchmark of a single graph
+struct suite_result {
+	std::string generator; //!< name of a generator
+	int vertices; //!< number of vertices
+	size_t edges; //!< number of undirected edges
+	double load_seconds; //!< time of graph_from_file
+	double parallel_load_seconds; //!< time of load_graph, which parses and builds a compressed sparse row graph on all threads, compares with load and freeze
+	double freeze_seconds; //!< time of freeze_graph
+	double bfs_seconds; //!< time of bfs
+	size_t bfs_edges; //!< number of half-edges scanned by bfs
+	double dfs_seconds; //!< time of dfs
+	size_t dfs_edges; //!< number of half-edges scanned by dfs
+	double mst_seconds; //!< time of maximum_spanning_tree
+	long peak_rss_kb; //!< peak resident set size of a child process that generated and measured only this graph
+};
+
+/**
+ * Measures a median time of a function in seconds, preparing every run outside of the measured time
+ * @param repeat: number of runs
+ * @param setup: function called before every run, not measured
+ * @param f: function to be measured
+ * @return median wall-clock time of a call
+ */
+template <typename S, typename F>
+double measure(int repeat, S&& setup, F&& f)
+{
+	std::vector<double> times;
+
+	for (int i = 0; i < repeat; i++) {
+		setup();
+		auto begin = std::chrono::steady_clock::now();
+		f();
+		auto end = std::chrono::steady_clock::now();
+		times.push_back(std::chrono::duration<double>(end - begin).count());
+	}
+
+	std::sort(times.begin(), times.end());
+	return times[times.size() / 2];
+}
+
+/**
+ * Measures a median time of a function in seconds
+ * @param repeat: number of runs
+ * @param f: function to be measured
+ * @return median wall-clock time of a call
+ */
+template <typename F>
+double measure(int repeat, F&& f)
+{
+	return measure(repeat, [] { }, f);
+}
+
+/**
+ * Returns peak resident set size of a process
+ * @return peak resident set size in kilobytes
+ */
+static long peak_rss_kb()
+{
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+/**
+ * Writes a list of edges in the input format of graph_from_file
+ * @param edges: list of edges
+ * @param path: path to an output file
+ * @return true if a file was written successfuly
+ */
+static bool write_edges(const std::vector<weighted_edge>& edges, const std::string& path)
+{
+	std::ofstream ost(path);
+	if (!ost) {
+		std::cerr << "Error: cannot open output file: " << path << std::endl;
+		return false;
+	}
+
+	for (const weighted_edge& e : edges)
+		ost << "(" << e.x << ", " << e.y << ", " << e.weight << "),\n";
+
+	return true;
+}
+
+/**
+ * Counts half-edges of vertices reached by a traversal
+ * @param c: traversed graph
+ * @param discovered: a vector that information if a given vertex is discovered
+ * @return sum of degrees of discovered vertices
+ */
+static size_t scanned_edges(const csr_graph& c, const std::vector<bool>& discovered)
+{
+	size_t count = 0;
+
+	for (int x = 0; x <= c.max_index; x++) {
+		if (discovered[x])
+			count += degree(c, x);
+	}
+
+	return count;
+}
+
+/**
+ * Runs all steps of a benchmark on a single generated graph
+ * @param generator: name of a generator
+ * @param edges: generated list of edges
+ * @param repeat: number of runs of every step
+ * @param file: temporary text file
+ * @param result: measured results
+ * @return true if a benchmark finished
+ */
+static bool run_suite(const std::string& generator, const std::vector<weighted_edge>& edges,
+	int repeat, const std::string& file, suite_result& result)
+{
+	if (write_edges(edges, file) == false)
+		return false;
+
+	graph g;
+	bool loaded = true;
+
+	result.load_seconds = measure(repeat, [&] {
+		free_graph(g);
+		loaded = graph_from_file(file, g);
+	});
+	result.parallel_load_seconds = measure(repeat, [&] {
+		csr_graph loaded_csr;
+		loaded = loaded && load_graph(file, loaded_csr);
+	});
+	std::remove(file.c_str());
+
+	if (!loaded)
+		return false;
+
+	csr_graph c;
+	result.freeze_seconds = measure(repeat, [&] { freeze_graph(g, c); });
+	free_graph(g);
+
+	// traversals start at a vertex of the greatest degree, which lies in the largest component of skewed graphs
+	int start = 0;
+	for (int x = 0; x <= c.max_index; x++) {
+		if (degree(c, x) > degree(c, start))
+			start = x;
+	}
+
+	result.generator = generator;
+	result.vertices = c.max_index + 1;
+	result.edges = edge_count(c) / 2;
+
+	// data is allocated and cleared outside of the measured time, so rates count only the traversal
+	bfs_data b(c);
+	result.bfs_seconds = measure(repeat, [&] { b = bfs_data(c); }, [&] {
+		bfs(c, start, b, null_visitor());
+	});
+	result.bfs_edges = scanned_edges(c, b.discovered);
+
+	dfs_data d(c);
+	result.dfs_seconds = measure(repeat, [&] { d = dfs_data(c); }, [&] {
+		dfs(c, start, d, null_visitor());
+	});
+	result.dfs_edges = scanned_edges(c, d.discovered);
+
+	mst_data m(c);
+	result.mst_seconds = measure(repeat, [&] { m = mst_data(c); }, [&] {
+		maximum_spanning_tree(c, start, m);
+	});
+
+	return true;
+}
+
+/**
+ * Generates a graph and runs a benchmark on it in a child process. The peak resident set size
+ * of a process never decreases, so only a separate process measures the peak of a single graph.
+ * The child sends its results back through a pipe as a line of text.
+ * @param generator: name of a generator
+ * @param scale: logarithm of a number of vertices
+ * @param degree: average number of edges per vertex
+ * @param seed: seed of a generated graph
+ * @param repeat: number of runs of every step
+ * @param file: temporary text file
+ * @param result: measured results
+ * @return true if a benchmark finished
+ */
+static bool run_isolated(const std::string& generator, int scale, int degree, unsigned seed,
+	int repeat, const std::string& file, suite_result& result)
+{
+	int fds[2];
+	if (pipe(fds) != 0) {
+		std::cerr << "Error: cannot create a pipe" << std::endl;
+		return false;
+	}
+
+	// output buffered by the streams is not written twice by the child
+	std::cout.flush();
+	std::cerr.flush();
+
+	pid_t pid = fork();
+	if (pid < 0) {
+		std::cerr << "Error: cannot start a benchmark process" << std::endl;
+		close(fds[0]);
+		close(fds[1]);
+		return false;
+	}
+
+	if (pid == 0) {
+		close(fds[0]);
+
+		std::vector<weighted_edge> edges;
+		if (generate_edges(generator, scale, degree, seed, edges) == false ||
+			run_suite(generator, edges, repeat, file, result) == false)
+			_exit(1);
+
+		std::ostringstream line;
+		line.precision(17);
+		line << result.vertices << " " << result.edges << " " << result.load_seconds << " "
+			<< result.parallel_load_seconds << " " << result.freeze_seconds << " "
+			<< result.bfs_seconds << " " << result.bfs_edges << " " << result.dfs_seconds << " "
+			<< result.dfs_edges << " " << result.mst_seconds << " " << peak_rss_kb() << "\n";
+
+		std::string text = line.str();
+		const char* p = text.data();
+		size_t n = text.size();
+		while (n > 0) {
+			ssize_t written = write(fds[1], p, n);
+			if (written <= 0)
+				_exit(1);
+			p += written;
+			n -= written;
+		}
+		_exit(0);
+	}
+
+	close(fds[1]);
+
+	std::string text;
+	char buffer[256];
+	ssize_t got;
+	while ((got = read(fds[0], buffer, sizeof(buffer))) > 0)
+		text.append(buffer, got);
+	close(fds[0]);
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+		return false;
+
+	std::istringstream line(text);
+	result.generator = generator;
+	line >> result.vertices >> result.edges >> result.load_seconds >> result.parallel_load_seconds
+		>> result.freeze_seconds >> result.bfs_seconds >> result.bfs_edges >> result.dfs_seconds
+		>> result.dfs_edges >> result.mst_seconds >> result.peak_rss_kb;
+
+	return bool(line);
+}
+
+/**
+ * Computes a throughput, keeping JSON valid for steps too fast to be measured
+ * @param count: number of processed items
+ * @param seconds: time of a step
+ * @return items per second, 0 if no time was measured
+ */
+static double rate(size_t count, double seconds)
+{
+	return seconds > 0 ? count / seconds : 0;
+}
+
+/**
+ * Prints results of all benchmarks as JSON
+ * @param results: results of benchmarks
+ * @param scale: logarithm of a number of vertices
+ * @param degree: average number of edges per vertex
+ * @param seed: seed of generated graphs
+ * @param ost: output stream
+ */
+static void print_json(const std::vector<suite_result>& results, int scale, int degree,
+	unsigned seed, std::ostream& ost)
+{
+	ost << "{\n  \"scale\": " << scale << ", \"degree\": " << degree << ", \"seed\": " << seed
+		<< ",\n  \"benchmarks\": [\n";
+
+	for (size_t i = 0; i < results.size(); i++) {
+		const suite_result& r = results[i];
+
+		ost << "    {\"generator\": \"" << r.generator << "\""
+			<< ", \"vertices\": " << r.vertices
+			<< ", \"edges\": " << r.edges
+			<< ",\n     \"load_seconds\": " << r.load_seconds
+			<< ", \"load_edges_per_second\": " << rate(r.edges, r.load_seconds)
+			<< ",\n     \"parallel_load_seconds\": " << r.parallel_load_seconds
+			<< ", \"parallel_load_edges_per_second\": " << rate(r.edges, r.parallel_load_seconds)
+			<< ",\n     \"freeze_seconds\": " << r.freeze_seconds
+			<< ",\n     \"bfs_seconds\": " << r.bfs_seconds
+			<< ", \"bfs_teps\": " << rate(r.bfs_edges, r.bfs_seconds)
+			<< ",\n     \"dfs_seconds\": " << r.dfs_seconds
+			<< ", \"dfs_teps\": " << rate(r.dfs_edges, r.dfs_seconds)
+			<< ",\n     \"mst_seconds\": " << r.mst_seconds
+			<< ", \"mst_edges_per_second\": " << rate(r.edges, r.mst_seconds)
+			<< ",\n     \"peak_rss_kb\": " << r.peak_rss_kb << "}"
+			<< (i + 1 < results.size() ? ",\n" : "\n");
+	}
+
+	ost << "  ]\n}" << std::endl;
+}
+
+/**
+ * Main program's function
+ * @param argc: number of command line arguments
+ * @param argv: an array of command line arguments
+ * @return return zero on program's exit
+ */
+int main(int argc, char** argv)
+{
+	const char* const short_opts = "g:n:d:s:r:f:o:h";
+
+	const option long_opts[] = {
+		{"generator", required_argument, nullptr, 'g'},
+		{"scale", required_argument, nullptr, 'n'},
+		{"degree", required_argument, nullptr, 'd'},
+		{"seed", required_argument, nullptr, 's'},
+		{"repeat", required_argument, nullptr, 'r'},
+		{"graph-file", required_argument, nullptr, 'f'},
+		{"output", required_argument, nullptr, 'o'},
+		{"help", no_argument, nullptr, 'h'},
+		{nullptr, no_argument, nullptr, 0}
+	};
+
+	std::string generator = "all";
+	int scale = 16;
+	int avg_degree = 16;
+	unsigned seed = 1;
+	int repeat = 3;
+	std::string graph_file = "bench_graph.txt";
+	std::string output_file_name;
+
+	while (true) {
+		const auto opt = getopt_long(argc, argv, short_opts, long_opts, nullptr);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'g':
+			generator = optarg;
+			break;
+		case 'n':
+			scale = std::atoi(optarg);
+			break;
+		case 'd':
+			avg_degree = std::atoi(optarg);
+			break;
+		case 's':
+			seed = std::atoi(optarg);
+			break;
+		case 'r':
+			repeat = std::max(1, std::atoi(optarg));
+			break;
+		case 'f':
+			graph_file = optarg;
+			break;
+		case 'o':
+			output_file_name = optarg;
+			break;
+		case 'h':
+		case '?':
+		default:
+			std::cout << help << std::endl;
+			return 0;
+		}
+	}
+
+	std::vector<std::string> generators;
+	if (generator == "all")
+		generators = { "rmat", "er", "grid", "path", "star" };
+	else
+		generators = { generator };
+
+	std::vector<suite_result> results;
+
+	for (const std::string& name : generators) {
+		suite_result result;
+		if (run_isolated(name, scale, avg_degree, seed, repeat, graph_file, result) == false)
+			return 0;
+
+		results.push_back(result);
+	}
+
+	if (output_file_name.empty()) {
+		print_json(results, scale, avg_degree, seed, std::cout);
+		return 0;
+	}
+
+	std::ofstream ost(output_file_name);
+	if (!ost) {
+		std::cerr << "Error: cannot open output file: " << output_file_name << std::endl;
+		return 0;
+	}
+	print_json(results, scale, avg_degree, seed, ost);
+
+	return 0;
+}
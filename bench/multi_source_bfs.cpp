@@ -0,0 +1,132 @@
+/**
+ * @file multi_source_bfs.cpp
+ * @author Jacek Falkowski
+ * @brief File contains a benchmark of a multi-source breadth-first search against a breadth-first search per source
+ */
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <getopt.h>
+#include <random>
+#include <string>
+#include "../include/csr_graph.h"
+#include "../include/bfs.h"
+#include "../include/multi_source_bfs.h"
+
+std::string help =
+R"(Measure time of breadth-first searches from many sources run one by one and in batches
+Usage: multi_source_bfs [OPTION]...
+Program options:
+--vertices -n=<val>:         number of vertices of a random graph, 262144 by default.
+--degree -d=<val>:           average number of edges per vertex, 8 by default.
+--sources -k=<val>:          number of random sources, 256 by default.
+--seed -s=<val>:             seed of a random graph, 1 by default.
+--help -h:                   show help
+)";
+
+/**
+ * Measures time of a function in seconds
+ * @param f: function to be measured
+ * @return wall-clock time of a call
+ */
+template <typename F>
+double measure(F&& f)
+{
+	auto begin = std::chrono::steady_clock::now();
+	f();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end - begin).count();
+}
+
+/**
+ * Main program's function
+ * @param argc: number of command line arguments
+ * @param argv: an array of command line arguments
+ * @return return zero on program's exit
+ */
+int main(int argc, char** argv)
+{
+	const char* const short_opts = "n:d:k:s:h";
+
+	const option long_opts[] = {
+		{"vertices", required_argument, nullptr, 'n'},
+		{"degree", required_argument, nullptr, 'd'},
+		{"sources", required_argument, nullptr, 'k'},
+		{"seed", required_argument, nullptr, 's'},
+		{"help", no_argument, nullptr, 'h'},
+		{nullptr, no_argument, nullptr, 0}
+	};
+
+	int vertices = 1 << 18;
+	int avg_degree = 8;
+	int num_sources = 256;
+	unsigned seed = 1;
+
+	while (true) {
+		const auto opt = getopt_long(argc, argv, short_opts, long_opts, nullptr);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'n':
+			vertices = std::atoi(optarg);
+			break;
+		case 'd':
+			avg_degree = std::atoi(optarg);
+			break;
+		case 'k':
+			num_sources = std::atoi(optarg);
+			break;
+		case 's':
+			seed = std::atoi(optarg);
+			break;
+		case 'h':
+		case '?':
+		default:
+			std::cout << help << std::endl;
+			return 0;
+		}
+	}
+
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> vertex(0, vertices - 1);
+	std::vector<weighted_edge> edges((size_t)vertices * avg_degree / 2);
+
+	for (weighted_edge& e : edges)
+		e = { vertex(rng), vertex(rng), 1.0 };
+
+	csr_graph c;
+	csr_from_edges(edges, c);
+
+	std::vector<int> sources(num_sources);
+	for (int& s : sources)
+		s = vertex(rng) % (c.max_index + 1);
+
+	ms_bfs_data batched(c, sources);
+	double batched_time = measure([&] { multi_source_bfs(c, batched); });
+
+	double single_time = measure([&] {
+		for (int s : sources) {
+			bfs_data data(c);
+			bfs(c, s, data, null_visitor());
+		}
+	});
+
+	size_t mismatches = 0;
+	for (size_t s = 0; s < sources.size(); s++) {
+		bfs_data data(c);
+		bfs(c, sources[s], data, null_visitor());
+
+		for (int x = 0; x <= c.max_index; x++)
+			mismatches += data.depth[x] != source_depth(batched, s, x);
+	}
+
+	std::cout << "bfs per source: " << single_time * 1e3 << " ms" << std::endl;
+	std::cout << "multi_source_bfs: " << batched_time * 1e3 << " ms" << std::endl;
+
+	if (mismatches)
+		std::cerr << "Error: " << mismatches << " depths differ from bfs" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file server_loadgen.cpp
+ * @author Jacek Falkowski
+ * @brief File contains a load generator that measures throughput and latency of the graph query server
+ */
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <getopt.h>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "../include/latency_histogram.h"
+#include "../include/query_protocol.h"
+
+std::string help =
+R"(Send queries between random vertices to a running graph server from many connections at once
+Usage: server_loadgen [OPTION]...
+Program options:
+--socket -s=<val>:           path of a Unix domain socket of a server.
+--query -q=<val>:            kind of queries, one of: info, bfs, reach, path, mst, bfs by default.
+--graph -g=<val>:            index of a graph of a server, 0 by default.
+--connections -c=<val>:      number of concurrent connections, each on its own thread, 4 by default.
+--queries -n=<val>:          number of queries sent on each connection, 1000 by default.
+--seed -S=<val>:             seed of random vertices, 1 by default.
+--help -h:                   show help
+)";
+
+//! Results of queries sent on a single connection
+struct connection_result {
+	latency_histogram latency; //!< round trip time of every query
+	size_t failed = 0; //!< number of queries answered with an error
+	bool connected = false; //!< false if a connection could not be made or broke
+};
+
+/**
+ * Sends queries on a single connection one after another, waiting for each answer
+ * @param socket_path: path of a socket of a server
+ * @param request: query whose source and target are replaced by random vertices
+ * @param vertices: number of vertices of a graph
+ * @param queries: number of queries to send
+ * @param seed: seed of random vertices
+ * @param result: collected results
+ */
+static void run_connection(const std::string& socket_path, query_request request, int64_t vertices,
+	int queries, unsigned seed, connection_result& result)
+{
+	int fd = connect_server(socket_path);
+	if (fd < 0)
+		return;
+
+	std::mt19937_64 rng(seed);
+	std::uniform_int_distribution<int64_t> vertex(0, vertices - 1);
+	query_response response;
+	std::vector<int64_t> items;
+
+	result.connected = true;
+
+	for (int i = 0; i < queries; i++) {
+		request.source = vertex(rng);
+		request.target = vertex(rng);
+
+		auto begin = std::chrono::steady_clock::now();
+		if (!run_query(fd, request, response, items)) {
+			result.connected = false;
+			break;
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		record_latency(result.latency, std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+		if (response.status != (uint32_t)query_status::ok)
+			result.failed++;
+	}
+
+	close(fd);
+}
+
+/**
+ * Main program's function
+ * @param argc: number of command line arguments
+ * @param argv: an array of command line arguments
+ * @return return zero on program's exit
+ */
+int main(int argc, char** argv)
+{
+	const char* const short_opts = "s:q:g:c:n:S:h";
+
+	const option long_opts[] = {
+		{"socket", required_argument, nullptr, 's'},
+		{"query", required_argument, nullptr, 'q'},
+		{"graph", required_argument, nullptr, 'g'},
+		{"connections", required_argument, nullptr, 'c'},
+		{"queries", required_argument, nullptr, 'n'},
+		{"seed", required_argument, nullptr, 'S'},
+		{"help", no_argument, nullptr, 'h'},
+		{nullptr, no_argument, nullptr, 0}
+	};
+
+	std::string socket_path;
+	query_op op = query_op::bfs;
+	uint32_t graph = 0;
+	int connections = 4;
+	int queries = 1000;
+	unsigned seed = 1;
+
+	while (true) {
+		const auto opt = getopt_long(argc, argv, short_opts, long_opts, nullptr);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 's':
+			socket_path = optarg;
+			break;
+		case 'q':
+			if (!parse_query_op(optarg, op) || op == query_op::latency) {
+				std::cerr << "Error: unknown query: " << optarg << std::endl;
+				return 0;
+			}
+			break;
+		case 'g':
+			graph = std::atoi(optarg);
+			break;
+		case 'c':
+			connections = std::atoi(optarg);
+			break;
+		case 'n':
+			queries = std::atoi(optarg);
+			break;
+		case 'S':
+			seed = std::atoi(optarg);
+			break;
+		case 'h':
+		case '?':
+		default:
+			std::cout << help << std::endl;
+			return 0;
+		}
+	}
+
+	if (socket_path.empty()) {
+		std::cerr << "Error: socket path not provided" << std::endl;
+		return 0;
+	}
+
+	// the size of a graph is asked first, so random vertices are always in range
+	query_request request = { static_cast<uint32_t>(query_op::info), graph, 0, 0 };
+	query_response response;
+	std::vector<int64_t> items;
+
+	int fd = connect_server(socket_path);
+	if (fd < 0)
+		return 0;
+
+	bool ok = run_query(fd, request, response, items);
+	close(fd);
+
+	if (!ok || response.status != (uint32_t)query_status::ok || response.vertices == 0) {
+		std::cerr << "Error: graph " << graph << " is not available" << std::endl;
+		return 0;
+	}
+
+	request.op = static_cast<uint32_t>(op);
+	std::vector<connection_result> results(connections);
+	std::vector<std::thread> threads;
+
+	auto begin = std::chrono::steady_clock::now();
+	for (int t = 0; t < connections; t++) {
+		threads.emplace_back(run_connection, std::cref(socket_path), request, (int64_t)response.vertices,
+			queries, seed + t, std::ref(results[t]));
+	}
+	for (std::thread& t : threads)
+		t.join();
+	auto end = std::chrono::steady_clock::now();
+
+	latency_histogram total;
+	size_t failed = 0;
+	int broken = 0;
+
+	for (const connection_result& r : results) {
+		merge_latency(total, r.latency);
+		failed += r.failed;
+		broken += r.connected ? 0 : 1;
+	}
+
+	double seconds = std::chrono::duration<double>(end - begin).count();
+	uint64_t answered = total.count.load();
+
+	std::cout << "{\n"
+		<< "  \"query\": \"" << query_op_name(op) << "\",\n"
+		<< "  \"connections\": " << connections << ",\n"
+		<< "  \"answered\": " << answered << ",\n"
+		<< "  \"failed\": " << failed << ",\n"
+		<< "  \"broken_connections\": " << broken << ",\n"
+		<< "  \"seconds\": " << seconds << ",\n"
+		<< "  \"queries_per_second\": " << (seconds > 0 ? answered / seconds : 0.0) << ",\n"
+		<< "  \"p50_us\": " << latency_percentile(total, 50) / 1000.0 << ",\n"
+		<< "  \"p90_us\": " << latency_percentile(total, 90) / 1000.0 << ",\n"
+		<< "  \"p99_us\": " << latency_percentile(total, 99) / 1000.0 << ",\n"
+		<< "  \"max_us\": " << total.max_ns.load() / 1000.0 << "\n"
+		<< "}" << std::endl;
+
+	return 0;
+}
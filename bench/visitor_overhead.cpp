@@ -0,0 +1,148 @@
+/**
+ * @file visitor_overhead.cpp
+ * @author Jacek Falkowski
+ * @brief File contains a benchmark of traversal hooks called through std::function and through visitors
+ */
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <getopt.h>
+#include <random>
+#include <string>
+#include "../include/csr_graph.h"
+#include "../include/bfs.h"
+#include "../include/dfs.h"
+
+std::string help =
+R"(Measure per-edge overhead of std::function callbacks and compile-time visitors in bfs and dfs
+Usage: visitor_overhead [OPTION]...
+Program options:
+--vertices -n=<val>:         number of vertices of a random graph, 1048576 by default.
+--degree -d=<val>:           average number of edges per vertex, 8 by default.
+--seed -s=<val>:             seed of a random graph, 1 by default.
+--help -h:                   show help
+)";
+
+//! visitor that counts calls of its hooks
+struct counting_visitor {
+	long vertices = 0; //!< number of vertex hooks
+	long edges = 0; //!< number of edge hooks
+
+	void process_vertex_early(int) { vertices++; }
+	void process_edge(int, int) { edges++; }
+	void process_vertex_late(int) { vertices++; }
+};
+
+/**
+ * Measures time of a function in seconds
+ * @param f: function to be measured
+ * @return wall-clock time of a call
+ */
+template <typename F>
+double measure(F&& f)
+{
+	auto begin = std::chrono::steady_clock::now();
+	f();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end - begin).count();
+}
+
+/**
+ * Prints a single result of a benchmark
+ * @param name: name of a measured variant
+ * @param seconds: time of a traversal
+ * @param edges: number of scanned half-edges
+ */
+void report(const std::string& name, double seconds, size_t edges)
+{
+	std::cout << name << ": " << seconds * 1e3 << " ms, "
+		<< seconds * 1e9 / edges << " ns/edge" << std::endl;
+}
+
+/**
+ * Main program's function
+ * @param argc: number of command line arguments
+ * @param argv: an array of command line arguments
+ * @return return zero on program's exit
+ */
+int main(int argc, char** argv)
+{
+	const char* const short_opts = "n:d:s:h";
+
+	const option long_opts[] = {
+		{"vertices", required_argument, nullptr, 'n'},
+		{"degree", required_argument, nullptr, 'd'},
+		{"seed", required_argument, nullptr, 's'},
+		{"help", no_argument, nullptr, 'h'},
+		{nullptr, no_argument, nullptr, 0}
+	};
+
+	int vertices = 1 << 20;
+	int avg_degree = 8;
+	unsigned seed = 1;
+
+	while (true) {
+		const auto opt = getopt_long(argc, argv, short_opts, long_opts, nullptr);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'n':
+			vertices = std::atoi(optarg);
+			break;
+		case 'd':
+			avg_degree = std::atoi(optarg);
+			break;
+		case 's':
+			seed = std::atoi(optarg);
+			break;
+		case 'h':
+		case '?':
+		default:
+			std::cout << help << std::endl;
+			return 0;
+		}
+	}
+
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> vertex(0, vertices - 1);
+	std::vector<weighted_edge> edges((size_t)vertices * avg_degree / 2);
+
+	for (weighted_edge& e : edges)
+		e = { vertex(rng), vertex(rng), 1.0 };
+
+	csr_graph c;
+	csr_from_edges(edges, c);
+	size_t half_edges = edge_count(c);
+
+	long vertex_calls = 0;
+	long edge_calls = 0;
+	counting_visitor counter;
+
+	bfs_data b1(c, [&] (int) { vertex_calls++; }, [&] (int, int) { edge_calls++; },
+		[&] (int) { vertex_calls++; });
+	report("bfs std::function", measure([&] { bfs(c, 0, b1); }), half_edges);
+
+	bfs_data b2(c);
+	report("bfs visitor", measure([&] { bfs(c, 0, b2, counter); }), half_edges);
+
+	bfs_data b3(c);
+	report("bfs null_visitor", measure([&] { bfs(c, 0, b3, null_visitor()); }), half_edges);
+
+	dfs_data d1(c, [&] (int) { vertex_calls++; }, [&] (int, int) { edge_calls++; },
+		[&] (int) { vertex_calls++; });
+	report("dfs std::function", measure([&] { dfs(c, 0, d1); }), half_edges);
+
+	dfs_data d2(c);
+	report("dfs visitor", measure([&] { dfs(c, 0, d2, counter); }), half_edges);
+
+	dfs_data d3(c);
+	report("dfs null_visitor", measure([&] { dfs(c, 0, d3, null_visitor()); }), half_edges);
+
+	// calls are checked, so the counting hooks cannot be optimized away
+	if (vertex_calls != counter.vertices || edge_calls != counter.edges)
+		std::cerr << "Error: callbacks and visitors were called a different number of times" << std::endl;
+
+	return 0;
+}
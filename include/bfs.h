@@ -6,15 +6,23 @@
 #pragma once
 
 #include "../include/graph.h"
+#include "../include/csr_graph.h"
+#include "../include/compressed_graph.h"
+#include "../include/external_graph.h"
+#include "../include/visitor.h"
+#include "../include/stats.h"
 
 #include <algorithm>
 #include <stack>
+#include <queue>
 #include <functional>
+#include <iostream>
 
-//! contains data needed to run breadth-first search algorithm
-struct bfs_data {
-        using vertex_callback = std::function<void(int)>;
-        using edge_callback = std::function<void(int, int)>;
+//! contains data needed to run breadth-first search algorithm, over a type of vertex indices
+template <typename Vertex>
+struct basic_bfs_data {
+        using vertex_callback = std::function<void(Vertex)>;
+        using edge_callback = std::function<void(Vertex, Vertex)>;
 
         /**
          * Initialize context
@@ -23,23 +31,269 @@ struct bfs_data {
          * @param process_edge: callback invoked when edge is processed
          * @param process_vertex_late: callback invoked when node is lately processed
          */
-        bfs_data(graph& g,
+        template <typename Weight>
+        basic_bfs_data(basic_graph<Vertex, Weight>& g,
                 vertex_callback&& process_vertex_early, edge_callback&& process_edge,
                 vertex_callback&& process_vertex_late);
 
+        /**
+         * Initialize context for a compressed sparse row graph
+         * @param c: graph on which algorithm will run
+         * @param process_vertex_early: callback invoked when node is initially processed
+         * @param process_edge: callback invoked when edge is processed
+         * @param process_vertex_late: callback invoked when node is lately processed
+         */
+        basic_bfs_data(const csr_graph& c,
+                vertex_callback&& process_vertex_early, edge_callback&& process_edge,
+                vertex_callback&& process_vertex_late);
+
+        /**
+         * Initialize context for a traversal with a visitor, callbacks do nothing
+         * @param g: graph on which algorithm will run
+         */
+        template <typename Weight>
+        basic_bfs_data(basic_graph<Vertex, Weight>& g);
+
+        /**
+         * Initialize context for a traversal of a compressed sparse row graph with a visitor,
+         * callbacks do nothing
+         * @param c: graph on which algorithm will run
+         */
+        basic_bfs_data(const csr_graph& c);
+
+        /**
+         * Initialize context for a traversal of a compressed graph with a visitor,
+         * callbacks do nothing
+         * @param z: graph on which algorithm will run
+         */
+        basic_bfs_data(const compressed_graph& z);
+
+        /**
+         * Initialize context for a traversal of a semi-external graph with a visitor,
+         * callbacks do nothing
+         * @param e: graph on which algorithm will run
+         */
+        basic_bfs_data(const external_graph& e);
+
         vertex_callback process_vertex_early;
         edge_callback process_edge;
         vertex_callback process_vertex_late;
 
         std::vector<bool> discovered;  //!< a vector that information if a given vertex is discovered
         std::vector<bool> processed;  //!< a vector that information if a given vertex is processed
-        std::vector<int> parent; //!< a vector that holds an index of a parent vertex for each of vertices
+        std::vector<Vertex> parent; //!< a vector that holds an index of a parent vertex for each of vertices
+        std::vector<Vertex> depth; //!< a vector that holds a distance in edges from a starting vertex, -1 if not discovered
 };
 
+using bfs_data = basic_bfs_data<int>;
+
 /**
  * Breadth-first search implementation based on Steven S. Skiena "The algorithm design manual".
  * @param x: starting vertex
  * @param dfs_context: context that algorithm will process
  * @param data: data needed to run an algorithm
  */
-void bfs(graph& g, int start, bfs_data& data);
+template <typename Vertex, typename Weight>
+void bfs(basic_graph<Vertex, Weight>& g, typename basic_graph<Vertex, Weight>::vertex_type start,
+        basic_bfs_data<Vertex>& data);
+
+/**
+ * Breadth-first search on a compressed sparse row graph.
+ * Vertices and edges are visited in the same order as on the adjacency list graph it was frozen from.
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ */
+void bfs(const csr_graph& c, int start, bfs_data& data);
+
+/**
+ * Breadth-first search on a compressed graph, decoding neighbour lists on the fly.
+ * Neighbours of each vertex are visited in ascending order.
+ * @param z: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ */
+void bfs(const compressed_graph& z, int start, bfs_data& data);
+
+/**
+ * Level-synchronous breadth-first search on a semi-external graph. Vertices of every level are sorted
+ * and their rows are streamed from disk in large sequential blocks, so a level costs one pass over
+ * the file instead of a random read per vertex. Depths are the same as of bfs on the graph in memory,
+ * vertices of a level are processed in increasing order, so a parent of a vertex is its smallest
+ * neighbour on the previous level. The number of bytes read is left in e.bytes_read.
+ * @param e: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ * @return false if reading a graph failed
+ */
+bool bfs(external_graph& e, int start, bfs_data& data);
+
+/**
+ * Direction-optimizing breadth-first search on a compressed sparse row graph.
+ * Small frontiers are expanded top-down, from the frontier to its neighbours. When the frontier
+ * grows large, each undiscovered vertex searches its own neighbours for a parent in the frontier
+ * instead (bottom-up), which skips most edges on low-diameter graphs.
+ * This is a callback-free fast path: the callbacks of data are not invoked. It fills discovered,
+ * processed, parent and depth. Depths are the same as those of bfs, parents form an equally valid
+ * breadth-first search tree but may differ from those chosen by bfs.
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ */
+void bfs_direction_optimizing(const csr_graph& c, int start, bfs_data& data);
+
+/**
+ * Breadth-first search with hooks of a visitor known at compile time, so they can be inlined
+ * into the loop. The callbacks of data are not used.
+ * @param g: graph to be traversed, graph or csr_graph
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ * @param visitor: object with process_vertex_early, process_edge and process_vertex_late members
+ */
+template <typename Graph, typename Vertex, typename Visitor>
+void bfs_visit(const Graph& g, Vertex start, basic_bfs_data<Vertex>& data, Visitor& visitor)
+{
+    std::queue<Vertex> q;
+    Vertex x;
+
+    GAL_STATS_BEGIN(stats);
+    GAL_STATS_PHASE(stats, "bfs");
+
+    q.push(start);
+    data.discovered[start] = true;
+    data.depth[start] = 0;
+    GAL_STATS_ADD(stats, vertices_discovered, 1);
+    GAL_STATS_LEVEL(stats, 0, frontier, 1);
+
+    while (!q.empty()) {
+        x = q.front();
+        q.pop();
+
+        visitor.process_vertex_early(x);
+        data.processed[x] = true;
+
+        for_each_edge(g, x, [&] (Vertex y, auto) {
+            GAL_STATS_ADD(stats, edges_scanned, 1);
+            GAL_STATS_LEVEL(stats, data.depth[x], edges, 1);
+
+            if (!data.processed[y])
+                visitor.process_edge(x, y);
+
+            if (!data.discovered[y]) {
+                data.discovered[y] = true;
+                q.push(y);
+                data.parent[y] = x;
+                data.depth[y] = data.depth[x] + 1;
+                GAL_STATS_ADD(stats, vertices_discovered, 1);
+                GAL_STATS_LEVEL(stats, data.depth[y], frontier, 1);
+            }
+        });
+        visitor.process_vertex_late(x);
+    }
+}
+
+/**
+ * Breadth-first search with a visitor known at compile time
+ * @param g: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ * @param visitor: object with process_vertex_early, process_edge and process_vertex_late members
+ */
+template <typename Vertex, typename Weight, typename Visitor>
+void bfs(basic_graph<Vertex, Weight>& g, typename basic_graph<Vertex, Weight>::vertex_type start,
+        basic_bfs_data<Vertex>& data, Visitor&& visitor)
+{
+    bfs_visit(g, start, data, visitor);
+}
+
+/**
+ * Breadth-first search on a compressed sparse row graph with a visitor known at compile time
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ * @param visitor: object with process_vertex_early, process_edge and process_vertex_late members
+ */
+template <typename Visitor>
+void bfs(const csr_graph& c, int start, bfs_data& data, Visitor&& visitor)
+{
+    bfs_visit(c, start, data, visitor);
+}
+
+/**
+ * Breadth-first search on a compressed graph with a visitor known at compile time
+ * @param z: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ * @param visitor: object with process_vertex_early, process_edge and process_vertex_late members
+ */
+template <typename Visitor>
+void bfs(const compressed_graph& z, int start, bfs_data& data, Visitor&& visitor)
+{
+    bfs_visit(z, start, data, visitor);
+}
+
+/**
+ * Level-synchronous breadth-first search on a semi-external graph with a visitor known at compile time
+ * @param e: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ * @param visitor: object with process_vertex_early, process_edge and process_vertex_late members
+ * @return false if reading a graph failed
+ */
+template <typename Visitor>
+bool bfs(external_graph& e, int start, bfs_data& data, Visitor&& visitor)
+{
+    if (start < 0 || start > e.max_index) {
+        std::cerr << "Error: start vertex is not in the graph" << std::endl;
+        return false;
+    }
+
+    std::vector<int> frontier(1, start);
+    std::vector<int> next;
+    external_block block;
+
+    reset_external_stats(e);
+    data.discovered[start] = true;
+    data.depth[start] = 0;
+
+    while (!frontier.empty()) {
+        int current = -1;
+
+        bool ok = scan_external_rows(e, frontier, false, block, [&] (int x, const int32_t* neighbors,
+            const double*, size_t count) {
+            // a long row arrives in several parts, hooks of a vertex surround all of them
+            if (x != current) {
+                if (current != -1)
+                    visitor.process_vertex_late(current);
+                current = x;
+                visitor.process_vertex_early(x);
+                data.processed[x] = true;
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                int y = neighbors[i];
+
+                if (!data.processed[y])
+                    visitor.process_edge(x, y);
+
+                if (!data.discovered[y]) {
+                    data.discovered[y] = true;
+                    data.parent[y] = x;
+                    data.depth[y] = data.depth[x] + 1;
+                    next.push_back(y);
+                }
+            }
+        });
+
+        if (!ok)
+            return false;
+        if (current != -1)
+            visitor.process_vertex_late(current);
+
+        std::sort(next.begin(), next.end());
+        frontier.swap(next);
+        next.clear();
+    }
+
+    return true;
+}
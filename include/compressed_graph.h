@@ -0,0 +1,106 @@
+/**
+ * @file compressed_graph.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a read-only graph with delta and varint encoded neighbour lists
+ */
+#pragma once
+
+#include "../include/csr_graph.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//! Read-only graph data structure with neighbours of each vertex sorted in ascending order and
+//! stored as varint encoded gaps. The first neighbour of vertex x is stored as a zigzag encoded
+//! difference from x, every next one as a difference from the previous one. Weights are stored
+//! separately, uncompressed, in the same order as neighbours.
+struct compressed_graph {
+	/**
+	 * Creates a new instance of an empty compressed graph
+	 */
+	compressed_graph();
+
+	int max_index; //!< maximal index of a vertex in a graph
+	std::vector<size_t> edge_offsets; //!< weights of edges of vertex x are stored at [edge_offsets[x], edge_offsets[x + 1])
+	std::vector<size_t> byte_offsets; //!< encoded neighbours of vertex x start at bytes[byte_offsets[x]]
+	std::vector<uint8_t> bytes; //!< encoded neighbours of all vertices
+	std::vector<double> weights; //!< weights of edges, stored in the order of sorted neighbours
+};
+
+/**
+ * Builds a compressed graph from a compressed sparse row graph
+ * @param c: graph to be compressed
+ * @param z: compressed graph that will be constructed
+ */
+void compress_graph(const csr_graph& c, compressed_graph& z);
+
+/**
+ * Returns a number of neighbours of a vertex
+ * @param z: compressed graph
+ * @param x: index of a vertex
+ * @return number of edges incident to x
+ */
+inline size_t degree(const compressed_graph& z, int x)
+{
+	return z.edge_offsets[x + 1] - z.edge_offsets[x];
+}
+
+/**
+ * Returns a number of stored half-edges, every undirected edge is stored twice
+ * @param z: compressed graph
+ * @return number of encoded neighbours
+ */
+inline size_t edge_count(const compressed_graph& z)
+{
+	return z.edge_offsets[z.max_index + 1];
+}
+
+/**
+ * Decodes a single varint and moves past it
+ * @param p: position of an encoded value
+ * @return decoded value
+ */
+inline uint32_t read_varint(const uint8_t*& p)
+{
+	uint32_t value = *p++;
+
+	// most gaps of sorted neighbour lists fit in a single byte
+	if (value < 0x80)
+		return value;
+
+	value &= 0x7f;
+	for (int shift = 7; ; shift += 7) {
+		uint32_t b = *p++;
+		value |= (b & 0x7f) << shift;
+		if (b < 0x80)
+			return value;
+	}
+}
+
+/**
+ * Invokes a function for every edge of a vertex, in ascending order of neighbours.
+ * Neighbours are decoded on the fly, the graph is never decompressed.
+ * @param z: compressed graph
+ * @param x: index of a vertex
+ * @param f: function called with an index of a neighbour and a weight of an edge
+ */
+template <typename F>
+inline void for_each_edge(const compressed_graph& z, int x, F&& f)
+{
+	size_t first = z.edge_offsets[x];
+	size_t last = z.edge_offsets[x + 1];
+
+	if (first == last)
+		return;
+
+	const uint8_t* p = z.bytes.data() + z.byte_offsets[x];
+	uint32_t zigzag = read_varint(p);
+	int y = x + (int)((zigzag >> 1) ^ (0u - (zigzag & 1)));
+	f(y, z.weights[first]);
+
+	for (size_t i = first + 1; i < last; i++) {
+		y += (int)read_varint(p);
+		f(y, z.weights[i]);
+	}
+}
@@ -0,0 +1,24 @@
+/**
+ * @file connected_components.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a parallel connected components algorithm
+ */
+#pragma once
+
+#include "../include/csr_graph.h"
+
+#include <vector>
+
+/**
+ * Labels connected components of a graph on multiple threads using the Afforest algorithm.
+ * First every vertex is united with its first few neighbours, which already merges most of
+ * the largest component. The largest component is then estimated from a sample of vertices,
+ * and only vertices outside of it process their remaining edges.
+ * Sets are united with a lock-free union-find, so the label of every vertex is the smallest
+ * vertex of its component.
+ * @param c: graph whose components will be labeled
+ * @param component: label of each vertex that will be filled
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ * @return number of components, isolated vertices included
+ */
+int connected_components(const csr_graph& c, std::vector<int>& component, int num_threads = 0);
@@ -0,0 +1,111 @@
+/**
+ * @file csr_graph.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of an immutable graph data structure stored in compressed sparse row format
+ */
+#pragma once
+
+#include "../include/graph.h"
+#include "../include/mapped_file.h"
+
+#include <vector>
+#include <cstddef>
+
+//! Undirected weighted edge x <--> y of an edge list
+struct weighted_edge {
+	int x; //!< index of a first vertex
+	int y; //!< index of a second vertex
+	double weight; //!< weight of an edge
+};
+
+//! Read-only graph data structure implemented using compressed sparse row format.
+//! Arrays point either into storage owned by the graph or into a mapped binary snapshot.
+struct csr_graph {
+	/**
+	 * Creates a new instance of an empty compressed sparse row graph
+	 */
+	csr_graph();
+
+	csr_graph(const csr_graph&) = delete;
+	csr_graph& operator=(const csr_graph&) = delete;
+
+	/**
+	 * Takes over arrays of another graph
+	 * @param other: graph to be moved from
+	 */
+	csr_graph(csr_graph&& other) noexcept;
+	csr_graph& operator=(csr_graph&& other) noexcept;
+
+	const size_t* offsets; //!< neighbours of vertex x are stored at [offsets[x], offsets[x + 1])
+	const int* neighbors; //!< packed indices of neighbouring vertices of each vertex
+	const double* weights; //!< packed weights of edges, stored in the same order as neighbors
+	int max_index; //!< maximal index of a vertex in a graph
+
+	std::vector<size_t> offset_storage; //!< offsets of a graph built in memory
+	std::vector<int> neighbor_storage; //!< neighbours of a graph built in memory
+	std::vector<double> weight_storage; //!< weights of a graph built in memory
+	mapped_file snapshot; //!< binary snapshot the arrays point into, if a graph was loaded from one
+};
+
+/**
+ * Points arrays of a graph at its own storage, after the storage was filled
+ * @param c: compressed sparse row graph
+ */
+void attach_storage(csr_graph& c);
+
+/**
+ * Builds a compressed sparse row graph from a populated adjacency list graph.
+ * Neighbours of each vertex are stored in the same order as in the adjacency list,
+ * so traversals visit vertices and edges in the same order on both structures.
+ * @param g: adjacency list graph to be frozen
+ * @param c: compressed sparse row graph that will be constructed
+ */
+void freeze_graph(graph& g, csr_graph& c);
+
+/**
+ * Builds a compressed sparse row graph directly from a list of undirected edges.
+ * The result is the same as inserting the edges with add_edge and calling freeze_graph.
+ * @param edges: list of undirected edges
+ * @param c: compressed sparse row graph that will be constructed
+ */
+void csr_from_edges(const std::vector<weighted_edge>& edges, csr_graph& c);
+
+/**
+ * Returns a number of neighbours of a vertex
+ * @param c: compressed sparse row graph
+ * @param x: index of a vertex
+ * @return number of edges incident to x
+ */
+inline size_t degree(const csr_graph& c, int x)
+{
+	return c.offsets[x + 1] - c.offsets[x];
+}
+
+/**
+ * Returns a number of stored half-edges, every undirected edge is stored twice
+ * @param c: compressed sparse row graph
+ * @return size of neighbors and weights arrays
+ */
+inline size_t edge_count(const csr_graph& c)
+{
+	return c.offsets[c.max_index + 1];
+}
+
+/**
+ * Invokes a function for every edge of a vertex, in the order they are stored
+ * @param c: compressed sparse row graph
+ * @param x: index of a vertex
+ * @param f: function called with an index of a neighbour and a weight of an edge
+ */
+template <typename F>
+inline void for_each_edge(const csr_graph& c, int x, F&& f)
+{
+	for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++)
+		f(c.neighbors[i], c.weights[i]);
+}
+
+/*
+ * Print a compressed sparse row graph.
+ * @param c: graph to be printed
+ */
+void print_graph(const csr_graph& c);
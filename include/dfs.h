@@ -6,15 +6,20 @@
 #pragma once
 
 #include "../include/graph.h"
+#include "../include/csr_graph.h"
+#include "../include/visitor.h"
+#include "../include/stats.h"
 
 #include <algorithm>
 #include <stack>
+#include <vector>
 #include <functional>
 
-//! contains data needed to run depth-first search algorithm
-struct dfs_data {
-        using vertex_callback = std::function<void(int)>;
-        using edge_callback = std::function<void(int, int)>;
+//! contains data needed to run depth-first search algorithm, over a type of vertex indices
+template <typename Vertex>
+struct basic_dfs_data {
+        using vertex_callback = std::function<void(Vertex)>;
+        using edge_callback = std::function<void(Vertex, Vertex)>;
 
         /**
          * Initialize context
@@ -23,23 +28,210 @@ struct dfs_data {
          * @param process_edge: callback invoked when edge is processed
          * @param process_vertex_late: callback invoked when node is lately processed
          */
-        dfs_data(graph& g,
+        template <typename Weight>
+        basic_dfs_data(basic_graph<Vertex, Weight>& g,
                 vertex_callback&& process_vertex_early, edge_callback&& process_edge,
                 vertex_callback&& process_vertex_late);
 
+        /**
+         * Initialize context for a compressed sparse row graph
+         * @param c: graph on which algorithm will run
+         * @param process_vertex_early: callback invoked when node is initially processed
+         * @param process_edge: callback invoked when edge is processed
+         * @param process_vertex_late: callback invoked when node is lately processed
+         */
+        basic_dfs_data(const csr_graph& c,
+                vertex_callback&& process_vertex_early, edge_callback&& process_edge,
+                vertex_callback&& process_vertex_late);
+
+        /**
+         * Initialize context for a traversal with a visitor, callbacks do nothing
+         * @param g: graph on which algorithm will run
+         */
+        template <typename Weight>
+        basic_dfs_data(basic_graph<Vertex, Weight>& g);
+
+        /**
+         * Initialize context for a traversal of a compressed sparse row graph with a visitor,
+         * callbacks do nothing
+         * @param c: graph on which algorithm will run
+         */
+        basic_dfs_data(const csr_graph& c);
+
         vertex_callback process_vertex_early;
         edge_callback process_edge;
         vertex_callback process_vertex_late;
 
         std::vector<bool> discovered;  //!< a vector that information if a given vertex is discovered
         std::vector<bool> processed;  //!< a vector that information if a given vertex is processed
-        std::vector<int> parent; //!< a vector that holds an index of a parent vertex for each of vertices
+        std::vector<Vertex> parent; //!< a vector that holds an index of a parent vertex for each of vertices
 };
 
+using dfs_data = basic_dfs_data<int>;
+
 /**
  * Depth-first search implementation based on Steven S. Skiena "The algorithm design manual".
  * @param x: starting vertex
  * @param dfs_context: context that algorithm will process
  * @param data: data needed to run an algorithm
  */
-void dfs(graph& g, int start, dfs_data& data);
+template <typename Vertex, typename Weight>
+void dfs(basic_graph<Vertex, Weight>& g, typename basic_graph<Vertex, Weight>::vertex_type start,
+        basic_dfs_data<Vertex>& data);
+
+/**
+ * Depth-first search on a compressed sparse row graph.
+ * Vertices and edges are visited in the same order as on the adjacency list graph it was frozen from.
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ */
+void dfs(const csr_graph& c, int start, dfs_data& data);
+
+//! frame of an explicit depth-first search stack on an adjacency list graph
+template <typename Vertex, typename Weight>
+struct basic_dfs_frame {
+    Vertex x; //!< vertex being explored
+    basic_edge<Vertex, Weight>* next; //!< next edge of x to be examined
+};
+
+using dfs_frame = basic_dfs_frame<int, double>;
+
+//! frame of an explicit depth-first search stack on a compressed sparse row graph
+struct csr_dfs_frame {
+    int x; //!< vertex being explored
+    size_t next; //!< index of the next edge of x to be examined
+};
+
+/**
+ * Depth-first search implementation based on Steven S. Skiena "The algorithm design manual".
+ * The recursion is replaced with an explicit stack of vertices and their edge cursors, so the depth
+ * of a search is not limited by the thread's stack. Hooks are invoked in the same order as
+ * in the recursive version.
+ * @param g: graph to be traversed
+ * @param x: starting vertex
+ * @param data: data needed to run an algorithm
+ * @param visitor: object with process_vertex_early, process_edge and process_vertex_late members
+ */
+template <typename Vertex, typename Weight, typename Visitor>
+void dfs_visit(const basic_graph<Vertex, Weight>& g, Vertex x, basic_dfs_data<Vertex>& data, Visitor& visitor)
+{
+    std::vector<basic_dfs_frame<Vertex, Weight>> stack;
+    stack.reserve(g.max_index + 1);
+
+    GAL_STATS_BEGIN(stats);
+    GAL_STATS_PHASE(stats, "dfs");
+
+    data.discovered[x] = true;
+    GAL_STATS_ADD(stats, vertices_discovered, 1);
+    visitor.process_vertex_early(x);
+    stack.push_back({ x, g.edges[x] });
+
+    while (!stack.empty()) {
+        basic_dfs_frame<Vertex, Weight>& f = stack.back();
+        x = f.x;
+
+        while (f.next != nullptr && data.discovered[f.next->y]) {
+            f.next = f.next->next;
+            GAL_STATS_ADD(stats, edges_scanned, 1);
+        }
+
+        if (f.next == nullptr) {
+            stack.pop_back();
+            data.processed[x] = true;
+            visitor.process_vertex_late(x);
+            continue;
+        }
+
+        Vertex y = f.next->y;
+        f.next = f.next->next;
+        GAL_STATS_ADD(stats, edges_scanned, 1);
+
+        data.parent[y] = x;
+        visitor.process_edge(x, y);
+
+        data.discovered[y] = true;
+        GAL_STATS_ADD(stats, vertices_discovered, 1);
+        visitor.process_vertex_early(y);
+        stack.push_back({ y, g.edges[y] });
+    }
+}
+
+/**
+ * Depth-first search on a compressed sparse row graph, using an explicit stack of vertices
+ * and their edge cursors. Hooks are invoked in the same order as in the recursive version.
+ * @param c: graph to be traversed
+ * @param x: starting vertex
+ * @param data: data needed to run an algorithm
+ * @param visitor: object with process_vertex_early, process_edge and process_vertex_late members
+ */
+template <typename Visitor>
+void dfs_visit(const csr_graph& c, int x, dfs_data& data, Visitor& visitor)
+{
+    std::vector<csr_dfs_frame> stack;
+    stack.reserve(c.max_index + 1);
+
+    GAL_STATS_BEGIN(stats);
+    GAL_STATS_PHASE(stats, "dfs");
+
+    data.discovered[x] = true;
+    GAL_STATS_ADD(stats, vertices_discovered, 1);
+    visitor.process_vertex_early(x);
+    stack.push_back({ x, c.offsets[x] });
+
+    while (!stack.empty()) {
+        csr_dfs_frame& f = stack.back();
+        x = f.x;
+
+        size_t end = c.offsets[x + 1];
+        while (f.next < end && data.discovered[c.neighbors[f.next]])
+            f.next++;
+
+        if (f.next == end) {
+            // every edge of a finished vertex was scanned exactly once
+            GAL_STATS_ADD(stats, edges_scanned, degree(c, x));
+            stack.pop_back();
+            data.processed[x] = true;
+            visitor.process_vertex_late(x);
+            continue;
+        }
+
+        int y = c.neighbors[f.next++];
+
+        data.parent[y] = x;
+        visitor.process_edge(x, y);
+
+        data.discovered[y] = true;
+        GAL_STATS_ADD(stats, vertices_discovered, 1);
+        visitor.process_vertex_early(y);
+        stack.push_back({ y, c.offsets[y] });
+    }
+}
+
+/**
+ * Depth-first search with hooks of a visitor known at compile time, so they can be inlined
+ * into the loop. The callbacks of data are not used.
+ * @param g: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ * @param visitor: object with process_vertex_early, process_edge and process_vertex_late members
+ */
+template <typename Vertex, typename Weight, typename Visitor>
+void dfs(basic_graph<Vertex, Weight>& g, typename basic_graph<Vertex, Weight>::vertex_type start,
+        basic_dfs_data<Vertex>& data, Visitor&& visitor)
+{
+    dfs_visit(g, start, data, visitor);
+}
+
+/**
+ * Depth-first search on a compressed sparse row graph with a visitor known at compile time
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ * @param visitor: object with process_vertex_early, process_edge and process_vertex_late members
+ */
+template <typename Visitor>
+void dfs(const csr_graph& c, int start, dfs_data& data, Visitor&& visitor)
+{
+    dfs_visit(c, start, data, visitor);
+}
@@ -0,0 +1,225 @@
+/**
+ * @file edge_scanner.h
+ * @author Jacek Falkowski
+ * @brief File contains a scanner of edges of the text input format shared by graph loaders
+ */
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+//! outcome of scanning a single token of an input file
+enum class scan_result {
+	ok, //!< token was read
+	fail, //!< token is malformed
+	end //!< input ended inside of a token
+};
+
+/**
+ * Checks if a character is a white space in the classic locale
+ * @param c: character to be checked
+ * @return true if c is a white space
+ */
+inline bool is_space(char c)
+{
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/**
+ * Checks if a character is a decimal digit
+ * @param c: character to be checked
+ * @return true if c is a digit
+ */
+inline bool is_digit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+/**
+ * Skips white spaces and reads a single character, like operator>> on char
+ * @param p: current position, advanced past the character
+ * @param end: end of input
+ * @param ch: read character
+ * @return scan_result::end if input ended before a character
+ */
+inline scan_result scan_char(const char*& p, const char* end, char& ch)
+{
+	while (p != end && is_space(*p))
+		p++;
+
+	if (p == end)
+		return scan_result::end;
+
+	ch = *p++;
+	return scan_result::ok;
+}
+
+/**
+ * Skips white spaces and reads a decimal integer, like operator>> on int
+ * @param p: current position, advanced past the integer
+ * @param end: end of input
+ * @param value: read integer, values out of the range of its type are malformed
+ * @return result of reading an integer
+ */
+template <typename Integer>
+inline scan_result scan_int(const char*& p, const char* end, Integer& value)
+{
+	while (p != end && is_space(*p))
+		p++;
+
+	const char* first = p;
+	const char* q = p;
+
+	if (q != end && (*q == '+' || *q == '-'))
+		q++;
+	while (q != end && is_digit(*q))
+		q++;
+
+	if (q == end)
+		return scan_result::end;
+
+	if (*first == '+')
+		first++;
+	if (first == q || !is_digit(q[-1]))
+		return scan_result::fail;
+
+	std::from_chars_result res = std::from_chars(first, q, value);
+	if (res.ec != std::errc() || res.ptr != q)
+		return scan_result::fail;
+
+	p = q;
+	return scan_result::ok;
+}
+
+/**
+ * Skips white spaces and reads a floating point number, like operator>> on double.
+ * Accepts the same characters as the stream does: an optional sign, digits with an optional
+ * decimal point and an optional exponent.
+ * @param p: current position, advanced past the number
+ * @param end: end of input
+ * @param value: read number
+ * @return result of reading a number
+ */
+inline scan_result scan_double(const char*& p, const char* end, double& value)
+{
+	while (p != end && is_space(*p))
+		p++;
+
+	const char* first = p;
+	const char* q = p;
+	bool found_mantissa = false;
+	bool found_dec = false;
+	bool found_sci = false;
+
+	if (q != end && (*q == '+' || *q == '-'))
+		q++;
+
+	while (q != end) {
+		if (is_digit(*q)) {
+			found_mantissa = true;
+			q++;
+		} else if (*q == '.' && !found_dec && !found_sci) {
+			found_dec = true;
+			q++;
+		} else if ((*q == 'e' || *q == 'E') && !found_sci && found_mantissa) {
+			found_sci = true;
+			q++;
+			if (q != end && (*q == '+' || *q == '-'))
+				q++;
+		} else {
+			break;
+		}
+	}
+
+	if (q == end)
+		return scan_result::end;
+
+	if (*first == '+')
+		first++;
+
+	std::from_chars_result res = std::from_chars(first, q, value);
+	if (res.ptr != q || res.ec == std::errc::invalid_argument)
+		return scan_result::fail;
+
+	// the stream rejects values that overflow to infinity, but accepts underflow
+	if (res.ec == std::errc::result_out_of_range) {
+		value = std::strtod(std::string(first, q).c_str(), nullptr);
+		if (std::isinf(value))
+			return scan_result::fail;
+	}
+
+	p = q;
+	return scan_result::ok;
+}
+
+/**
+ * Skips white spaces and reads a weight of an edge. Integer weights are read as integers,
+ * floating point weights are read as doubles and rejected if they overflow a narrower type.
+ * @param p: current position, advanced past the weight
+ * @param end: end of input
+ * @param value: read weight
+ * @return result of reading a weight
+ */
+template <typename Weight>
+inline scan_result scan_weight(const char*& p, const char* end, Weight& value)
+{
+	if constexpr (std::is_integral<Weight>::value) {
+		return scan_int(p, end, value);
+	} else {
+		double wide;
+		scan_result res = scan_double(p, end, wide);
+
+		if (res != scan_result::ok)
+			return res;
+
+		if (std::fabs(wide) > std::numeric_limits<Weight>::max())
+			return scan_result::fail;
+
+		value = static_cast<Weight>(wide);
+		return res;
+	}
+}
+
+/**
+ * Reads a single edge "(x, y, weight)" followed by an optional comma, like the stream
+ * operators would. Characters that are not where the format puts them make an edge malformed.
+ * @param p: current position, advanced past the edge
+ * @param end: end of input
+ * @param x: index of a first vertex
+ * @param y: index of a second vertex
+ * @param weight: weight of an edge
+ * @return result of reading an edge
+ */
+template <typename Vertex, typename Weight>
+inline scan_result scan_edge(const char*& p, const char* end, Vertex& x, Vertex& y, Weight& weight)
+{
+	char ch1, ch2, ch3, ch4;
+	scan_result res;
+
+	if ((res = scan_char(p, end, ch1)) != scan_result::ok)
+		return res;
+	if ((res = scan_int(p, end, x)) != scan_result::ok)
+		return res;
+	if ((res = scan_char(p, end, ch2)) != scan_result::ok)
+		return res;
+	if ((res = scan_int(p, end, y)) != scan_result::ok)
+		return res;
+	if ((res = scan_char(p, end, ch3)) != scan_result::ok)
+		return res;
+	if ((res = scan_weight(p, end, weight)) != scan_result::ok)
+		return res;
+	if ((res = scan_char(p, end, ch4)) != scan_result::ok)
+		return res;
+
+	if (ch1 != '(' || ch2 != ',' || ch3 != ',' || ch4 != ')')
+		return scan_result::fail;
+
+	if (p != end && *p == ',')
+		p++;
+
+	return scan_result::ok;
+}
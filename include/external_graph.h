@@ -0,0 +1,137 @@
+/**
+ * @file external_graph.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a semi-external graph whose edges stay in a snapshot file on disk
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+static const size_t default_external_block = 4 << 20; //!< default number of bytes of neighbours read at once
+
+//! Read-only graph for semi-external algorithms. Only row offsets are kept in memory, neighbours
+//! and weights are read from a binary graph snapshot in large blocks with pread, so memory use is
+//! proportional to the number of vertices and a block size, not to the number of edges.
+struct external_graph {
+	/**
+	 * Creates a graph that is not open
+	 */
+	external_graph();
+
+	external_graph(const external_graph&) = delete;
+	external_graph& operator=(const external_graph&) = delete;
+
+	/**
+	 * Closes a snapshot file
+	 */
+	~external_graph();
+
+	int fd; //!< descriptor of a snapshot file, -1 if a graph is not open
+	std::string path; //!< path of a snapshot file
+	int max_index; //!< maximal index of a vertex in a graph
+	uint64_t edges; //!< number of stored half-edges
+	std::vector<uint64_t> offsets; //!< neighbours of vertex x are stored at [offsets[x], offsets[x + 1]) of the file arrays
+	uint64_t neighbors_position; //!< position of the first neighbour in a file
+	uint64_t weights_position; //!< position of the first weight in a file
+	size_t block_edges; //!< number of half-edges read by a single block read
+
+	uint64_t bytes_read; //!< bytes read from a file by the last run of an algorithm
+	uint64_t reads; //!< number of reads issued by the last run of an algorithm
+};
+
+//! Block of consecutive half-edges read from a file, reused between reads
+struct external_block {
+	uint64_t first = 0; //!< index of the first half-edge in a block
+	uint64_t last = 0; //!< index past the last half-edge in a block
+	std::vector<int32_t> neighbors; //!< neighbours of half-edges [first, last)
+	std::vector<double> weights; //!< weights of half-edges [first, last), empty if they were not requested
+};
+
+/**
+ * Opens a binary graph snapshot for semi-external algorithms. The header is validated and offsets
+ * are read into memory, the rest of a file is left on disk and is not checksummed, neighbours are
+ * range checked as their blocks are read instead.
+ * @param path: path to a snapshot written by save_graph_binary
+ * @param e: graph that will be backed by a file
+ * @param block_bytes: number of bytes of neighbours read at once
+ * @return true if a snapshot was opened successfuly
+ */
+bool open_external_graph(const std::string& path, external_graph& e, size_t block_bytes = default_external_block);
+
+/**
+ * Resets counters of bytes and reads, called at the beginning of every run
+ * @param e: graph
+ */
+void reset_external_stats(external_graph& e);
+
+/**
+ * Reads a block of half-edges starting at a given one, at most block_edges long, checks that every
+ * neighbour is a vertex of a graph and hints the kernel to read ahead the block that follows it
+ * @param e: graph
+ * @param first: index of the first half-edge to read
+ * @param last: index past the last half-edge that a caller needs, the block may end earlier or later
+ * @param with_weights: true to read weights as well as neighbours
+ * @param block: block that receives half-edges
+ * @return false if a read failed or a neighbour is not a vertex of a graph
+ */
+bool read_external_block(external_graph& e, uint64_t first, uint64_t last, bool with_weights, external_block& block);
+
+/**
+ * Returns a number of neighbours of a vertex
+ * @param e: semi-external graph
+ * @param x: index of a vertex
+ * @return number of edges incident to x
+ */
+inline size_t degree(const external_graph& e, int x)
+{
+	return e.offsets[x + 1] - e.offsets[x];
+}
+
+/**
+ * Streams rows of vertices given in increasing order, reading neighbours in large sequential blocks.
+ * A block covers as many consecutive rows as fit in it, rows of vertices that are not listed are read
+ * only when they lie between listed ones in the same block. Rows longer than a block are passed in parts.
+ * @param e: graph
+ * @param vertices: vertices whose rows are read, sorted in increasing order
+ * @param with_weights: true to read weights as well as neighbours
+ * @param block: reused block buffer
+ * @param f: function called with a vertex, a pointer to its neighbours, a pointer to their weights
+ *           (nullptr without weights) and a number of neighbours, once for a vertex without edges
+ *           and possibly several times for a vertex with a long row
+ * @return false if a read failed or a block held an invalid neighbour
+ */
+template <typename F>
+bool scan_external_rows(external_graph& e, const std::vector<int>& vertices, bool with_weights,
+	external_block& block, F&& f)
+{
+	for (size_t k = 0; k < vertices.size(); k++) {
+		int x = vertices[k];
+		uint64_t i = e.offsets[x];
+		uint64_t end = e.offsets[x + 1];
+
+		if (i == end)
+			f(x, nullptr, nullptr, 0);
+
+		while (i < end) {
+			if (i < block.first || i >= block.last || (with_weights && block.weights.size() < block.last - block.first)) {
+				// the block reaches to the end of the furthest listed row that still fits into it
+				uint64_t want = end;
+				for (size_t j = k + 1; j < vertices.size() && e.offsets[vertices[j] + 1] - i <= e.block_edges; j++)
+					want = e.offsets[vertices[j] + 1];
+
+				if (!read_external_block(e, i, want, with_weights, block))
+					return false;
+			}
+
+			uint64_t stop = end < block.last ? end : block.last;
+			size_t at = i - block.first;
+			f(x, block.neighbors.data() + at, with_weights ? block.weights.data() + at : nullptr, (size_t)(stop - i));
+			i = stop;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file generators.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of seeded generators of synthetic graphs
+ */
+#pragma once
+
+#include "../include/csr_graph.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// every generator draws weights of edges uniformly from [0, 100) and is fully determined
+// by its parameters and seed, so the same call produces the same edge list on every run
+
+/**
+ * Generates a recursive matrix (R-MAT) graph, a Kronecker-like power-law graph used by Graph500.
+ * Every edge picks one quadrant of the adjacency matrix per bit of a vertex index.
+ * @param scale: logarithm of a number of vertices
+ * @param edge_factor: number of edges per vertex
+ * @param seed: seed of a random number generator
+ * @return list of 2^scale * edge_factor edges, self-loops and duplicates included
+ */
+std::vector<weighted_edge> rmat_edges(int scale, int edge_factor, uint64_t seed);
+
+/**
+ * Generates an Erdos-Renyi G(n, m) graph with uniformly random endpoints
+ * @param vertices: number of vertices
+ * @param edges: number of edges
+ * @param seed: seed of a random number generator
+ * @return list of edges, self-loops and duplicates included
+ */
+std::vector<weighted_edge> erdos_renyi_edges(int vertices, size_t edges, uint64_t seed);
+
+/**
+ * Generates a two-dimensional grid where every vertex is connected to its right and lower neighbour
+ * @param rows: number of rows
+ * @param cols: number of columns
+ * @param seed: seed of a random number generator
+ * @return list of edges, vertex at row r and column c has index r * cols + c
+ */
+std::vector<weighted_edge> grid_edges(int rows, int cols, uint64_t seed);
+
+/**
+ * Generates a path 0 - 1 - ... - (n - 1)
+ * @param vertices: number of vertices
+ * @param seed: seed of a random number generator
+ * @return list of n - 1 edges
+ */
+std::vector<weighted_edge> path_edges(int vertices, uint64_t seed);
+
+/**
+ * Generates a star with vertex 0 in the middle
+ * @param vertices: number of vertices
+ * @param seed: seed of a random number generator
+ * @return list of n - 1 edges
+ */
+std::vector<weighted_edge> star_edges(int vertices, uint64_t seed);
+
+/**
+ * Generates a graph of a given kind with about 2^scale vertices
+ * @param kind: one of rmat, er, grid, path, star
+ * @param scale: logarithm of a number of vertices
+ * @param degree: average number of edges per vertex, used by rmat and er
+ * @param seed: seed of a random number generator
+ * @param edges: list of edges that will be generated
+ * @return true if a kind is known
+ */
+bool generate_edges(const std::string& kind, int scale, int degree, uint64_t seed,
+	std::vector<weighted_edge>& edges);
@@ -5,79 +5,196 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <iostream>
 
-//! Singly-linked list of graph's edges
-struct edge {
+//! Singly-linked list of graph's edges.
+//! The graph is instantiated for int and int64_t vertex indices combined with
+//! double, float and uint32_t weights, int and double being the default.
+template <typename Vertex, typename Weight>
+struct basic_edge {
+	using vertex_type = Vertex; //!< type of an index of a vertex
+	using weight_type = Weight; //!< type of a weight of an edge
+
 	/**
 	 * Constucts a new edge
 	 * @param y: index of a vertex
 	 * @param weight: weight of an edge
 	 * @param next: a pointer to a next edge in a linked list
 	 */
-	edge(int y, double weight, edge* next);
+	basic_edge(Vertex y, Weight weight, basic_edge* next);
 
-	int y; //!< index of a vertex to which an edge is pointing
-	double weight; //!< weight of an edge
-	struct edge* next; //!< a pointer to next element in the linked list
+	Vertex y; //!< index of a vertex to which an edge is pointing
+	Weight weight; //!< weight of an edge
+	basic_edge* next; //!< a pointer to next element in the linked list
 };
 
+using edge = basic_edge<int, double>;
+
 /**
  * Insert new edge at the beggining of the list
  * @param head: head of the linked list
  * @param y: index of a vertex
  * @param weight: weight of an edge
  */
-void insert_front(edge*& head, int y, double weight);
+template <typename Vertex, typename Weight>
+void insert_front(basic_edge<Vertex, Weight>*& head, typename basic_edge<Vertex, Weight>::vertex_type y,
+	typename basic_edge<Vertex, Weight>::weight_type weight);
 
 /*
  * Print a linked list.
  * @param head: head of a linked list to be printed
  */
-void print_edges(edge* head);
+template <typename Vertex, typename Weight>
+void print_edges(basic_edge<Vertex, Weight>* head);
 
 /*
- * Free a linked list.
+ * Free a linked list of edges allocated with new.
  * @param head: head of a linked list to be freed
  */
-void free_edges(edge* head);
+template <typename Vertex, typename Weight>
+void free_edges(basic_edge<Vertex, Weight>* head);
+
+//! Chunked arena that owns edge nodes of a graph and releases them slab by slab
+template <typename Vertex, typename Weight>
+struct basic_edge_arena {
+	/**
+	 * Creates a new empty arena
+	 */
+	basic_edge_arena();
+
+	basic_edge_arena(const basic_edge_arena&) = delete;
+	basic_edge_arena& operator=(const basic_edge_arena&) = delete;
+
+	/**
+	 * Takes over all slabs of another arena
+	 * @param other: arena to be moved from
+	 */
+	basic_edge_arena(basic_edge_arena&& other) noexcept;
+	basic_edge_arena& operator=(basic_edge_arena&& other) noexcept;
+
+	/**
+	 * Releases all slabs of an arena
+	 */
+	~basic_edge_arena();
+
+	std::vector<basic_edge<Vertex, Weight>*> slabs; //!< blocks of memory from which edges are allocated
+	basic_edge<Vertex, Weight>* cursor; //!< first free node of the current slab
+	basic_edge<Vertex, Weight>* limit; //!< end of the current slab
+	size_t slab_size; //!< number of nodes in the next slab to be allocated
+};
+
+using edge_arena = basic_edge_arena<int, double>;
+
+/**
+ * Allocates a contiguous block of uninitialized edge nodes from an arena
+ * @param arena: arena from which nodes are allocated
+ * @param n: number of nodes in a block
+ * @return pointer to the first node of a block
+ */
+template <typename Vertex, typename Weight>
+basic_edge<Vertex, Weight>* reserve_edges(basic_edge_arena<Vertex, Weight>& arena, size_t n);
+
+/**
+ * Insert new edge allocated from an arena at the beggining of the list
+ * @param arena: arena that owns the new edge
+ * @param head: head of the linked list
+ * @param y: index of a vertex
+ * @param weight: weight of an edge
+ */
+template <typename Vertex, typename Weight>
+void insert_front(basic_edge_arena<Vertex, Weight>& arena, basic_edge<Vertex, Weight>*& head,
+	typename basic_edge<Vertex, Weight>::vertex_type y, typename basic_edge<Vertex, Weight>::weight_type weight);
+
+/**
+ * Releases all edges of an arena at once
+ * @param arena: arena to be released
+ */
+template <typename Vertex, typename Weight>
+void release_arena(basic_edge_arena<Vertex, Weight>& arena);
+
+//! Graph data structure implemented using adjacency list, over types of vertex indices and edge weights
+template <typename Vertex, typename Weight>
+struct basic_graph {
+	using vertex_type = Vertex; //!< type of an index of a vertex
+	using weight_type = Weight; //!< type of a weight of an edge
 
-//! Graph data structure implemented using adjacency list
-struct graph {
 	/**
 	 * Creates a new instance of a graph data structure
 	 */
-	graph();
+	basic_graph();
 
-	std::vector<edge*> edges; //!< list of neighbours of each vertex
-	int max_index; //!< maximal index of a vertex in a graph
+	std::vector<basic_edge<Vertex, Weight>*> edges; //!< list of neighbours of each vertex
+	Vertex max_index; //!< maximal index of a vertex in a graph
+	size_t num_edges; //!< number of undirected edges inserted with add_edge
+	basic_edge_arena<Vertex, Weight> arena; //!< storage of all edges inserted with add_edge
 };
 
+using graph = basic_graph<int, double>;
+
+//! invokes a macro with every combination of a vertex index type and a weight type
+//! that the graph and algorithms on it are instantiated for
+#define GAL_GRAPH_TYPES(F) \
+	F(int, double) \
+	F(int, float) \
+	F(int, uint32_t) \
+	F(int64_t, double) \
+	F(int64_t, float) \
+	F(int64_t, uint32_t)
+
 /**
  * Insert undirected edge x <--> y edge into adjacency list
  * @param x: index of a first vertex
  * @param y: index of a second vertex
  * @param weight: weight of an edge
  */
-void add_edge(graph& g, int x, int y, double weight);
+template <typename Vertex, typename Weight>
+void add_edge(basic_graph<Vertex, Weight>& g, typename basic_graph<Vertex, Weight>::vertex_type x,
+	typename basic_graph<Vertex, Weight>::vertex_type y, typename basic_graph<Vertex, Weight>::weight_type weight);
+
+/**
+ * Invokes a function for every edge of a vertex, in the order of its adjacency list
+ * @param g: graph
+ * @param x: index of a vertex
+ * @param f: function called with an index of a neighbour and a weight of an edge
+ */
+template <typename Vertex, typename Weight, typename F>
+inline void for_each_edge(const basic_graph<Vertex, Weight>& g, typename basic_graph<Vertex, Weight>::vertex_type x, F&& f)
+{
+	for (basic_edge<Vertex, Weight>* p = g.edges[x]; p != nullptr; p = p->next)
+		f(p->y, p->weight);
+}
 
 /*
  * Print a graph.
  * @param g: graph to be printed
  */
-void print_graph(graph& g);
+template <typename Vertex, typename Weight>
+void print_graph(basic_graph<Vertex, Weight>& g);
 
 /*
- * Free a graph.
+ * Free a graph. Edges owned by graph's arena are released slab by slab,
+ * edges inserted with insert_front without an arena must be freed with free_edges.
  * @param g: graph to be freed
  */
-void free_graph(graph& g);
+template <typename Vertex, typename Weight>
+void free_graph(basic_graph<Vertex, Weight>& g);
+
+/**
+ * Moves edges of each vertex next to each other in a single block of memory,
+ * keeping the order of every adjacency list.
+ * @param g: graph to be compacted
+ */
+template <typename Vertex, typename Weight>
+void compact_graph(basic_graph<Vertex, Weight>& g);
 
 /**
- * Initializes a graph with a data from an input file
+ * Initializes a graph with a data from an input file. Integer weights must be written as integers,
+ * floating point weights that overflow a weight type make a file malformed.
  * @param path: path to an input file
  * @param g: graph that will be constructed with a data from a file
  * @return true if a graph was read from an input file successfuly
  */
-bool graph_from_file(const std::string& path, graph& g);
+template <typename Vertex, typename Weight>
+bool graph_from_file(const std::string& path, basic_graph<Vertex, Weight>& g);
@@ -0,0 +1,53 @@
+/**
+ * @file graph_loader.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of multi-threaded loaders of graphs from text input files
+ */
+#pragma once
+
+#include "../include/graph.h"
+#include "../include/csr_graph.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * Reads all edges of an input file on multiple threads. A file is split into chunks that begin
+ * at an opening parenthesis of an edge, and every chunk is parsed into a buffer of its own.
+ * Edges are returned in the order of a file, and a file is accepted or rejected exactly as
+ * by graph_from_file.
+ * @param path: path to an input file
+ * @param edges: list of edges that will be filled with edges of a file
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ * @return true if edges were read from an input file successfuly
+ */
+bool edges_from_file(const std::string& path, std::vector<weighted_edge>& edges, int num_threads = 0);
+
+/**
+ * Builds an adjacency list graph from a list of undirected edges on multiple threads.
+ * Degrees are counted, prefix-summed into positions of rows and edges are scattered into
+ * a single block of nodes. The result is the same as inserting the edges with add_edge
+ * and calling compact_graph.
+ * @param edges: list of undirected edges
+ * @param g: graph that will be constructed, its previous edges are released
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ */
+void build_graph(const std::vector<weighted_edge>& edges, graph& g, int num_threads = 0);
+
+/**
+ * Builds a compressed sparse row graph from a list of undirected edges on multiple threads.
+ * The result is the same as of csr_from_edges.
+ * @param edges: list of undirected edges
+ * @param c: compressed sparse row graph that will be constructed
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ */
+void build_csr(const std::vector<weighted_edge>& edges, csr_graph& c, int num_threads = 0);
+
+/**
+ * Initializes a graph with a data from an input file on multiple threads
+ * @param path: path to an input file
+ * @param g: graph that will be constructed with a data from a file, its previous edges are released
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ * @return true if a graph was read from an input file successfuly
+ */
+bool parallel_graph_from_file(const std::string& path, graph& g, int num_threads = 0);
@@ -0,0 +1,142 @@
+/**
+ * @file graph_server.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a server that keeps graphs in memory and answers queries over a Unix domain socket
+ */
+#pragma once
+
+#include "../include/csr_graph.h"
+#include "../include/latency_histogram.h"
+#include "../include/query_protocol.h"
+#include "../include/workspace.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//! Graph kept in memory by a server, with workspaces of queries running on it
+struct served_graph {
+	/**
+	 * Takes over a loaded graph
+	 * @param name: path that a graph was loaded from
+	 * @param c: loaded graph
+	 */
+	served_graph(const std::string& name, csr_graph&& c);
+
+	std::string name; //!< path that a graph was loaded from
+	csr_graph graph; //!< graph answering queries
+	workspace_pool pool; //!< workspaces checked out by workers of a server
+};
+
+//! State of a single worker thread of a server, reused by all queries it answers
+struct server_worker {
+	/**
+	 * Creates a worker of a server with a given number of graphs
+	 * @param num_graphs: number of graphs of a server
+	 */
+	server_worker(size_t num_graphs);
+
+	std::vector<std::unique_ptr<traversal_workspace>> workspaces; //!< workspace of each graph, checked out on the first query on it
+	std::vector<int64_t> items; //!< items of the current response
+	std::vector<char> buffer; //!< encoded response
+	latency_histogram latency[query_op_count]; //!< latencies of answered queries of each kind
+};
+
+//! Request that has fully arrived on a connection and waits for a worker
+struct pending_request {
+	int fd; //!< connected socket
+	query_request request; //!< query read from it
+};
+
+//! Server that answers queries on graphs loaded once. A poller thread accepts connections, waits
+//! on all of them at once and reads requests without blocking. A request that has fully arrived
+//! is handed to a worker thread, which answers it and hands its connection back to the poller.
+//! Idle clients and clients that send a request slowly hold only a descriptor, never a worker,
+//! and a client that does not read its answers is disconnected after a timeout.
+struct graph_server {
+	/**
+	 * Creates a server without graphs that is not listening
+	 */
+	graph_server();
+
+	graph_server(const graph_server&) = delete;
+	graph_server& operator=(const graph_server&) = delete;
+
+	/**
+	 * Stops a server if it is still running
+	 */
+	~graph_server();
+
+	std::vector<std::unique_ptr<served_graph>> graphs; //!< graphs in order they were added
+	std::vector<std::unique_ptr<server_worker>> workers; //!< state of each worker thread
+	std::string socket_path; //!< path of a listening socket
+	int listen_fd; //!< listening socket, -1 if a server is not running
+	int wake_fd[2]; //!< pipe that wakes a poller when a connection is handed back or a server stops
+
+	std::atomic<bool> stopping; //!< set when a server stops
+	std::mutex lock; //!< guards pending, returned and connections
+	std::condition_variable ready; //!< signalled when a connection is pending or a server stops
+	std::deque<pending_request> pending; //!< requests waiting for a worker
+	std::deque<int> returned; //!< connections handed back by workers, waiting to be polled again
+	std::vector<int> connections; //!< connections being served
+	std::vector<std::thread> threads; //!< poller and worker threads
+};
+
+/**
+ * Loads a graph from a text edge list or a binary snapshot and adds it to a server.
+ * Graphs are numbered in order they are added, and must be added before a server starts.
+ * @param s: server that is not running
+ * @param path: path to an input file
+ * @param num_threads: number of threads used to load a graph, 0 means all hardware threads
+ * @return true if a graph was loaded successfuly
+ */
+bool add_graph(graph_server& s, const std::string& path, int num_threads = 0);
+
+/**
+ * Answers a query on a graph, keeping traversal state in a workspace.
+ * Latency queries need a server and are answered by it.
+ * @param c: graph
+ * @param ws: workspace of a graph
+ * @param request: query
+ * @param response: answer, item_count is set when it is sent
+ * @param items: items of an answer
+ */
+void answer_query(const csr_graph& c, traversal_workspace& ws, const query_request& request,
+	query_response& response, std::vector<int64_t>& items);
+
+/**
+ * Starts listening on a Unix domain socket and answering queries on a pool of worker threads.
+ * A stale socket file left by a previous server is replaced.
+ * @param s: server with all its graphs added
+ * @param socket_path: path of a socket
+ * @param num_threads: number of worker threads, 0 means all hardware threads
+ * @return true if a server started
+ */
+bool start_server(graph_server& s, const std::string& socket_path, int num_threads = 0);
+
+/**
+ * Stops accepting connections, closes connections being served and waits for all threads
+ * @param s: server
+ */
+void stop_server(graph_server& s);
+
+/**
+ * Collects latencies of queries of a kind from all workers of a server
+ * @param s: server
+ * @param op: kind of queries
+ * @param h: histogram that receives samples
+ */
+void server_latency(const graph_server& s, query_op op, latency_histogram& h);
+
+/**
+ * Prints latency histograms of every kind of queries that a server answered
+ * @param s: server
+ * @param os: output stream
+ */
+void print_server_latency(const graph_server& s, std::ostream& os);
@@ -0,0 +1,83 @@
+/**
+ * @file graph_snapshot.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a binary graph snapshot format that can be memory-mapped directly
+ */
+#pragma once
+
+#include "../include/graph.h"
+#include "../include/csr_graph.h"
+
+#include <cstdint>
+#include <string>
+
+//! Header of a binary graph snapshot. It is followed by vertex_count + 1 offsets (uint64_t),
+//! edge_count neighbours (int32_t), padding to 8 bytes and edge_count weights (double),
+//! all stored in the byte order of the machine that wrote a snapshot.
+struct snapshot_header {
+	char magic[8]; //!< identifies a snapshot file, always "GALCSR\r\n"
+	uint32_t version; //!< version of a snapshot layout
+	uint32_t header_size; //!< size of a header in bytes
+	uint64_t vertex_count; //!< number of vertices, max_index + 1
+	uint64_t edge_count; //!< number of stored half-edges
+	uint64_t checksum; //!< checksum of everything that follows a header
+};
+
+/**
+ * Checks if a file starts with the magic number of a binary graph snapshot
+ * @param path: path to a file
+ * @return true if a file is a binary graph snapshot
+ */
+bool is_graph_snapshot(const std::string& path);
+
+/**
+ * Checks if a header describes a snapshot of a supported version whose arrays fill a file exactly
+ * @param header: header read from the beginning of a file
+ * @param file_size: size of a whole file in bytes, at least the size of a header
+ * @param path: path to a file, used in error messages
+ * @return true if a header is valid
+ */
+bool check_snapshot_header(const snapshot_header& header, uint64_t file_size, const std::string& path);
+
+/**
+ * Returns a position of the first neighbour in a snapshot file
+ * @param header: header of a snapshot
+ * @return offset in bytes from the beginning of a file
+ */
+uint64_t snapshot_neighbors_offset(const snapshot_header& header);
+
+/**
+ * Returns a position of the first weight in a snapshot file
+ * @param header: header of a snapshot
+ * @return offset in bytes from the beginning of a file
+ */
+uint64_t snapshot_weights_offset(const snapshot_header& header);
+
+/**
+ * Saves a compressed sparse row graph as a binary snapshot
+ * @param c: graph to be saved
+ * @param path: path to an output file
+ * @return true if a snapshot was written successfuly
+ */
+bool save_graph_binary(const csr_graph& c, const std::string& path);
+
+/**
+ * Maps a binary snapshot into memory. The arrays of a graph point directly into the mapping,
+ * so a graph is ready to use without any deserialization.
+ * @param path: path to a snapshot
+ * @param c: graph that will be backed by a snapshot
+ * @param verify: if true, the checksum of a whole snapshot is verified, which reads every page
+ * @return true if a snapshot was loaded successfuly
+ */
+bool load_graph_binary(const std::string& path, csr_graph& c, bool verify = true);
+
+/**
+ * Loads a graph either from a binary snapshot or from a text edge list,
+ * choosing a loader by the magic number at the beginning of a file.
+ * Text edge lists are parsed and built on multiple threads.
+ * @param path: path to an input file
+ * @param c: graph that will be constructed with a data from a file
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ * @return true if a graph was read from an input file successfuly
+ */
+bool load_graph(const std::string& path, csr_graph& c, int num_threads = 0);
@@ -0,0 +1,63 @@
+/**
+ * @file incremental_mst.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a maximum spanning forest maintained under edge insertions
+ */
+#pragma once
+
+#include "../include/graph.h"
+#include "../include/csr_graph.h"
+#include "../include/spanning_tree.h"
+#include "../include/link_cut_tree.h"
+
+#include <vector>
+
+//! Maximum spanning forest of a growing graph. Edges of the forest are kept in a link-cut tree,
+//! every edge as a node of its own between the nodes of its vertices, so the lightest edge on a
+//! path between two vertices is found in amortized O(log n) time.
+//! The forest stored in data must be a maximum spanning forest of the graph when the structure is
+//! created, for example one computed by maximum_spanning_forest or by maximum_spanning_tree of a
+//! connected graph. Insertions update only the link-cut tree, parents and distances in data are
+//! rebuilt by materialize_forest. The graph and data must not be modified in other ways while it is in use.
+struct incremental_mst {
+	/**
+	 * Starts maintaining a maximum spanning forest
+	 * @param g: graph that edges will be added to
+	 * @param data: maximum spanning forest of g, brought up to date by materialize_forest
+	 */
+	incremental_mst(graph& g, mst_data& data);
+
+	graph& g; //!< graph that edges are added to
+	mst_data& data; //!< maximum spanning forest of g as of the last materialize_forest
+	link_cut_tree tree; //!< forest of vertex and edge nodes
+	std::vector<int> vertex_node; //!< node of each vertex
+	std::vector<int> edge_x; //!< first vertex of each edge node, -1 for vertex nodes
+	std::vector<int> edge_y; //!< second vertex of each edge node, -1 for vertex nodes
+};
+
+/**
+ * Adds an edge to a graph and updates its maximum spanning forest. If both vertices are
+ * already connected, the lightest edge on the forest path between them is replaced when the new
+ * edge is heavier. An insertion takes amortized O(log n) time, data is not changed by it.
+ * @param m: maintained maximum spanning forest
+ * @param x: index of a first vertex
+ * @param y: index of a second vertex
+ * @param weight: weight of an edge
+ * @return true if the edge became part of the forest
+ */
+bool insert_edge(incremental_mst& m, int x, int y, double weight);
+
+/**
+ * Adds a batch of edges to a graph and updates its maximum spanning forest
+ * @param m: maintained maximum spanning forest
+ * @param edges: edges to be added, in order
+ * @return number of edges that became part of the forest
+ */
+size_t insert_edges(incremental_mst& m, const std::vector<weighted_edge>& edges);
+
+/**
+ * Writes the current forest into data in O(n) time. Every tree is rooted at its smallest vertex,
+ * like the forests of maximum_spanning_forest: roots have distance 0 and parent -1.
+ * @param m: maintained maximum spanning forest
+ */
+void materialize_forest(incremental_mst& m);
@@ -0,0 +1,67 @@
+/**
+ * @file indexed_heap.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of an indexed d-ary max-heap of vertices
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+//! Entry of an indexed heap
+template <typename Vertex>
+struct basic_heap_entry {
+	double key; //!< priority of a vertex
+	Vertex vertex; //!< index of a vertex
+};
+
+using heap_entry = basic_heap_entry<int>;
+
+//! Indexed 4-ary max-heap of vertices with an increase-key operation, over a type of vertex indices.
+//! Vertices with equal keys are popped in increasing order of their indices.
+//! Instantiated for int and int64_t indices.
+template <typename Vertex>
+struct basic_indexed_heap {
+	using vertex_type = Vertex; //!< type of an index of a vertex
+
+	/**
+	 * Creates an empty heap
+	 * @param capacity: number of vertices, vertices have indices in [0, capacity)
+	 */
+	basic_indexed_heap(Vertex capacity);
+
+	std::vector<basic_heap_entry<Vertex>> entries; //!< heap ordered array of entries
+	std::vector<Vertex> position; //!< position of each vertex in entries, -1 if a vertex is not in a heap
+};
+
+using indexed_heap = basic_indexed_heap<int>;
+
+/**
+ * Inserts a vertex into a heap or increases its key if it is already there.
+ * A key that is not greater than the current one is ignored.
+ * @param h: heap
+ * @param vertex: index of a vertex
+ * @param key: new key of a vertex
+ */
+template <typename Vertex>
+void heap_push_or_increase(basic_indexed_heap<Vertex>& h, typename basic_indexed_heap<Vertex>::vertex_type vertex,
+	double key);
+
+/**
+ * Removes a vertex with the greatest key from a heap
+ * @param h: non-empty heap
+ * @return index of the removed vertex
+ */
+template <typename Vertex>
+Vertex heap_pop(basic_indexed_heap<Vertex>& h);
+
+/**
+ * Checks if a heap is empty
+ * @param h: heap
+ * @return true if a heap contains no vertices
+ */
+template <typename Vertex>
+inline bool heap_empty(const basic_indexed_heap<Vertex>& h)
+{
+	return h.entries.empty();
+}
@@ -0,0 +1,72 @@
+/**
+ * @file latency_histogram.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a histogram of latencies with power of two buckets
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+static const int latency_buckets = 64; //!< number of buckets of a histogram, enough for any 64-bit latency
+
+//! Histogram of latencies in nanoseconds. Bucket b counts latencies in [2^b, 2^(b+1)),
+//! bucket 0 also counts zero. Samples are recorded by a single thread, while other threads
+//! may read or merge a histogram at the same time.
+struct latency_histogram {
+	/**
+	 * Creates an empty histogram
+	 */
+	latency_histogram();
+
+	/**
+	 * Copies counts of another histogram
+	 * @param other: histogram to be copied
+	 */
+	latency_histogram(const latency_histogram& other);
+	latency_histogram& operator=(const latency_histogram& other);
+
+	std::atomic<uint64_t> buckets[latency_buckets]; //!< number of samples in each bucket
+	std::atomic<uint64_t> count; //!< number of samples
+	std::atomic<uint64_t> total_ns; //!< sum of all samples
+	std::atomic<uint64_t> max_ns; //!< largest sample
+};
+
+/**
+ * Returns a bucket of a latency
+ * @param ns: latency in nanoseconds
+ * @return index of a bucket
+ */
+int latency_bucket(uint64_t ns);
+
+/**
+ * Adds a sample to a histogram. Must not be called by two threads on the same histogram at once.
+ * @param h: histogram
+ * @param ns: latency in nanoseconds
+ */
+void record_latency(latency_histogram& h, uint64_t ns);
+
+/**
+ * Adds all samples of one histogram to another
+ * @param into: histogram that receives samples
+ * @param from: histogram whose samples are added
+ */
+void merge_latency(latency_histogram& into, const latency_histogram& from);
+
+/**
+ * Estimates a percentile of latencies as the upper bound of a bucket that holds it
+ * @param h: histogram
+ * @param p: percentile in [0, 100]
+ * @return latency in nanoseconds, at most the largest sample, 0 if a histogram is empty
+ */
+uint64_t latency_percentile(const latency_histogram& h, double p);
+
+/**
+ * Prints a summary of a histogram and its non-empty buckets
+ * @param h: histogram
+ * @param name: name printed in front of a summary
+ * @param os: output stream
+ */
+void print_latency(const latency_histogram& h, const std::string& name, std::ostream& os);
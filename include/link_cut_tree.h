@@ -0,0 +1,71 @@
+/**
+ * @file link_cut_tree.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a link-cut tree with path minimum queries
+ */
+#pragma once
+
+#include <vector>
+
+//! Forest of rooted trees that supports linking, cutting and finding a node of the smallest value
+//! on a path in amortized O(log n) time. Paths are kept in splay trees, a node whose splay tree
+//! parent does not have it as a child holds a path-parent pointer instead.
+struct link_cut_tree {
+	std::vector<int> left; //!< left child of each node in its splay tree, -1 if none
+	std::vector<int> right; //!< right child of each node in its splay tree, -1 if none
+	std::vector<int> up; //!< splay tree parent or path-parent of each node, -1 if none
+	std::vector<char> flip; //!< true if children of a subtree of a node are to be swapped
+	std::vector<double> value; //!< value of each node
+	std::vector<int> best; //!< node of the smallest value in a splay subtree of each node
+	std::vector<int> path; //!< storage of nodes on the way to a splay tree root, reused by splay
+};
+
+/**
+ * Adds a new single-node tree
+ * @param t: link-cut tree
+ * @param value: value of a node
+ * @return index of a new node
+ */
+int lct_add_node(link_cut_tree& t, double value);
+
+/**
+ * Changes a value of a node that is not linked to any other node
+ * @param t: link-cut tree
+ * @param x: index of a single-node tree
+ * @param value: new value of a node
+ */
+void lct_set_value(link_cut_tree& t, int x, double value);
+
+/**
+ * Checks if two nodes are in the same tree
+ * @param t: link-cut tree
+ * @param x: index of a first node
+ * @param y: index of a second node
+ * @return true if there is a path between x and y
+ */
+bool lct_connected(link_cut_tree& t, int x, int y);
+
+/**
+ * Connects two nodes of different trees with an edge
+ * @param t: link-cut tree
+ * @param x: index of a first node
+ * @param y: index of a second node
+ */
+void lct_link(link_cut_tree& t, int x, int y);
+
+/**
+ * Removes an edge between two adjacent nodes
+ * @param t: link-cut tree
+ * @param x: index of a first node
+ * @param y: index of a second node
+ */
+void lct_cut(link_cut_tree& t, int x, int y);
+
+/**
+ * Finds a node of the smallest value on a path between two nodes of the same tree
+ * @param t: link-cut tree
+ * @param x: index of a first node
+ * @param y: index of a second node
+ * @return index of a node of the smallest value
+ */
+int lct_path_min(link_cut_tree& t, int x, int y);
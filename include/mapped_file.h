@@ -0,0 +1,52 @@
+/**
+ * @file mapped_file.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a read-only memory-mapped file
+ */
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+//! Read-only view of a whole file, memory-mapped when the file supports it
+struct mapped_file {
+	/**
+	 * Creates an empty view
+	 */
+	mapped_file();
+
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+
+	/**
+	 * Takes over a mapping or a buffer of another view
+	 * @param other: view to be moved from
+	 */
+	mapped_file(mapped_file&& other) noexcept;
+	mapped_file& operator=(mapped_file&& other) noexcept;
+
+	/**
+	 * Unmaps a file
+	 */
+	~mapped_file();
+
+	const char* data; //!< first byte of a file
+	size_t size; //!< size of a file in bytes
+	bool mapped; //!< true if data points to a memory mapping, false if it points to buffer
+	std::string buffer; //!< contents of files that cannot be mapped, e.g. pipes
+};
+
+/**
+ * Maps a whole file into memory for sequential reading.
+ * Files that cannot be mapped are read into a buffer instead.
+ * @param path: path to a file
+ * @param file: view that will be initialized
+ * @return true if a file was opened successfuly
+ */
+bool map_file(const std::string& path, mapped_file& file);
+
+/**
+ * Releases a mapping or a buffer of a file
+ * @param file: view to be released
+ */
+void unmap_file(mapped_file& file);
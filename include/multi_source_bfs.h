@@ -0,0 +1,64 @@
+/**
+ * @file multi_source_bfs.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a bit-parallel multi-source breadth-first search algorithm
+ */
+#pragma once
+
+#include "../include/csr_graph.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+static const int ms_bfs_batch = 64; //!< number of sources traversed together, one bit of a mask each
+
+//! contains data needed to run breadth-first searches from many sources at once
+struct ms_bfs_data {
+	//! callback invoked with a vertex, its depth, index of the first source of a batch
+	//! and a mask of sources of a batch that reached the vertex at that depth
+	using batch_callback = std::function<void(int, int, size_t, uint64_t)>;
+
+	/**
+	 * Initialize context that collects a depth of every vertex from every source
+	 * @param c: graph on which algorithm will run
+	 * @param sources: starting vertices
+	 */
+	ms_bfs_data(const csr_graph& c, const std::vector<int>& sources);
+
+	/**
+	 * Initialize context that reports reached vertices to a callback and does not collect depths
+	 * @param c: graph on which algorithm will run
+	 * @param sources: starting vertices
+	 * @param process_vertices: callback invoked when a vertex is reached from some sources of a batch
+	 */
+	ms_bfs_data(const csr_graph& c, const std::vector<int>& sources, batch_callback&& process_vertices);
+
+	batch_callback process_vertices;
+
+	std::vector<int> sources; //!< starting vertices
+	int vertices; //!< number of vertices of a graph, max_index + 1
+	std::vector<int> depth; //!< distance in edges of vertex x from source s at s * vertices + x, -1 if not reachable, empty if a callback is used
+};
+
+/**
+ * Depth of a vertex from a source collected by multi_source_bfs
+ * @param data: data of a finished search
+ * @param s: index of a source in data.sources
+ * @param x: index of a vertex
+ * @return distance in edges, -1 if x is not reachable from a source
+ */
+inline int source_depth(const ms_bfs_data& data, size_t s, int x)
+{
+	return data.depth[s * data.vertices + x];
+}
+
+/**
+ * Multi-source breadth-first search. Sources are traversed in batches of ms_bfs_batch, and every
+ * vertex holds a mask of sources of a batch that have seen it and a mask of sources for which it
+ * is in a frontier, so each level reads the edges of a graph once for the whole batch instead of
+ * once per source. Depths are the same as those of bfs run from each source separately.
+ * @param c: graph to be traversed
+ * @param data: data needed to run an algorithm
+ */
+void multi_source_bfs(const csr_graph& c, ms_bfs_data& data);
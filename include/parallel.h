@@ -0,0 +1,39 @@
+/**
+ * @file parallel.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of helpers that run loops of graph algorithms on multiple threads
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+//! body of a parallel loop, invoked with a range [begin, end) and an index of a thread that runs it
+using parallel_body = std::function<void(size_t begin, size_t end, int thread)>;
+
+/**
+ * Returns a number of threads that a parallel algorithm will use
+ * @param num_threads: number of threads requested by a caller, 0 means all hardware threads
+ * @return number of threads, at least one
+ */
+int parallel_thread_count(int num_threads);
+
+/**
+ * Pins pool threads to cores, or stops pinning new ones. Pinning keeps threads next to data
+ * they touched in previous loops, but should be left off on machines shared with other services.
+ * @param pin: true to pin pool threads
+ */
+void parallel_pin_threads(bool pin);
+
+/**
+ * Splits a range into chunks and runs a body on them on multiple threads of a shared pool.
+ * A calling thread starts with the whole range and keeps splitting off halves, threads that
+ * run out of work steal the largest ranges left, so uneven chunks are balanced. A body may call
+ * parallel_for again, the inner loop is joined only by idle pool threads.
+ * @param first: beginning of a range
+ * @param last: end of a range
+ * @param grain: number of iterations in a single chunk
+ * @param body: function invoked for every chunk with a thread index in [0, parallel_thread_count(num_threads))
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ */
+void parallel_for(size_t first, size_t last, size_t grain, const parallel_body& body, int num_threads = 0);
@@ -0,0 +1,24 @@
+/**
+ * @file parallel_bfs.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a multi-threaded level-synchronous breadth-first search algorithm
+ */
+#pragma once
+
+#include "../include/csr_graph.h"
+#include "../include/bfs.h"
+
+/**
+ * Level-synchronous breadth-first search on multiple threads. Vertices of each level are split
+ * between threads, a thread claims an undiscovered neighbour by setting its bit in a shared
+ * discovered bitmap with an atomic operation, and collects claimed vertices in its own frontier.
+ * Frontiers of all threads are merged into the next level at the level boundary.
+ * Like bfs_direction_optimizing, the callbacks of data are not invoked. It fills discovered,
+ * processed, parent and depth. Depths are the same as those of bfs, parents form an equally valid
+ * breadth-first search tree that depends on the order in which threads claim vertices.
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ */
+void parallel_bfs(const csr_graph& c, int start, bfs_data& data, int num_threads = 0);
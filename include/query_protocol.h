@@ -0,0 +1,118 @@
+/**
+ * @file query_protocol.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of the request/response protocol of the graph query server
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//! Kind of a query. Every query names a graph of a server by its position on the command line.
+enum class query_op : uint32_t {
+	info, //!< size of a graph: vertices holds max_index + 1, value the number of stored half-edges
+	bfs, //!< breadth-first search from source: vertices holds reached vertices, value the largest depth, items the size of each level
+	reach, //!< checks if target is reachable from source: value is 1 or 0, vertices holds vertices discovered until target was found
+	path, //!< path with the fewest edges from source to target: items hold its vertices, value its length, -1 if there is none, vertices as for reach
+	mst, //!< maximum spanning tree of the component of source: vertices holds spanned vertices, value its weight
+	latency //!< latency histogram of queries of kind source: vertices holds their number, value the mean in nanoseconds, items the counts of latency_histogram buckets followed by the largest latency
+};
+
+static const int query_op_count = 6; //!< number of kinds of queries
+
+//! Outcome of a query
+enum class query_status : uint32_t {
+	ok, //!< query was answered
+	bad_op, //!< kind of a query is unknown
+	bad_graph, //!< server has no graph with a requested index
+	bad_vertex //!< source or target is not a vertex of a graph
+};
+
+//! Query sent by a client, fixed size and in the byte order of the machine, as the server runs locally
+struct query_request {
+	uint32_t op; //!< kind of a query, one of query_op
+	uint32_t graph; //!< index of a graph of a server
+	int64_t source; //!< starting vertex
+	int64_t target; //!< destination vertex, ignored by queries that do not need one
+};
+
+//! Header of an answer to a query, followed by item_count int64_t items
+struct query_response {
+	uint32_t status; //!< outcome of a query, one of query_status
+	uint32_t item_count; //!< number of items that follow a header
+	uint64_t vertices; //!< number of vertices, meaning depends on the kind of a query
+	double value; //!< scalar result, meaning depends on the kind of a query
+};
+
+/**
+ * Returns a name of a kind of a query
+ * @param op: kind of a query
+ * @return name used by command line tools, "unknown" if op is out of range
+ */
+const char* query_op_name(query_op op);
+
+/**
+ * Finds a kind of a query by its name
+ * @param name: name used by command line tools
+ * @param op: found kind of a query
+ * @return false if there is no query of that name
+ */
+bool parse_query_op(const std::string& name, query_op& op);
+
+/**
+ * Reads exactly n bytes from a socket, retrying interrupted and partial reads
+ * @param fd: socket
+ * @param buffer: destination of n bytes
+ * @param n: number of bytes
+ * @return false if a socket was closed or failed before n bytes arrived
+ */
+bool receive_fully(int fd, void* buffer, size_t n);
+
+/**
+ * Writes exactly n bytes to a socket, retrying interrupted and partial writes.
+ * A peer that went away is reported as a failure instead of raising SIGPIPE.
+ * @param fd: socket
+ * @param buffer: source of n bytes
+ * @param n: number of bytes
+ * @return false if a socket was closed or failed before n bytes were written
+ */
+bool send_fully(int fd, const void* buffer, size_t n);
+
+/**
+ * Sends a response header together with its items in a single write
+ * @param fd: socket
+ * @param response: header, item_count is set from items
+ * @param items: items of a response
+ * @param buffer: scratch buffer reused between responses
+ * @return false if a socket failed
+ */
+bool send_response(int fd, query_response& response, const std::vector<int64_t>& items,
+	std::vector<char>& buffer);
+
+/**
+ * Receives a response header and its items
+ * @param fd: socket
+ * @param response: received header
+ * @param items: received items
+ * @return false if a socket failed or was closed
+ */
+bool receive_response(int fd, query_response& response, std::vector<int64_t>& items);
+
+/**
+ * Connects to a query server listening on a Unix domain socket
+ * @param path: path of a socket
+ * @return connected socket, -1 if a server cannot be reached
+ */
+int connect_server(const std::string& path);
+
+/**
+ * Sends a query to a server and waits for its answer
+ * @param fd: socket connected with connect_server
+ * @param request: query to be sent
+ * @param response: received header
+ * @param items: received items
+ * @return false if a connection failed
+ */
+bool run_query(int fd, const query_request& request, query_response& response, std::vector<int64_t>& items);
@@ -0,0 +1,58 @@
+/**
+ * @file radix_heap.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a monotone radix min-heap of vertices
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//! Entry of a radix heap
+struct radix_entry {
+	uint64_t key; //!< bit pattern of a non-negative double key
+	int vertex; //!< index of a vertex
+};
+
+//! Monotone min-heap of vertices keyed by non-negative doubles, as used by Dijkstra's algorithm.
+//! Keys are never smaller than the last popped key, so an entry is kept in the bucket of the
+//! highest bit in which its key differs from that key, and every entry is moved at most 64 times.
+//! Non-negative doubles compare like their bit patterns, so keys are stored as integers.
+//! A vertex may be pushed many times, stale entries are filtered out by a caller.
+struct radix_heap {
+	/**
+	 * Creates an empty heap
+	 */
+	radix_heap();
+
+	uint64_t last; //!< key of the last popped entry
+	size_t count; //!< number of entries in a heap
+	std::vector<radix_entry> buckets[65]; //!< bucket 0 holds keys equal to last, bucket i keys differing from it first in bit i - 1
+};
+
+/**
+ * Inserts a vertex into a heap
+ * @param h: heap
+ * @param vertex: index of a vertex
+ * @param key: non-negative key, not smaller than the last popped key
+ */
+void radix_push(radix_heap& h, int vertex, double key);
+
+/**
+ * Removes an entry with the smallest key from a heap
+ * @param h: non-empty heap
+ * @param key: key of the removed entry
+ * @return index of the removed vertex
+ */
+int radix_pop(radix_heap& h, double& key);
+
+/**
+ * Checks if a heap is empty
+ * @param h: heap
+ * @return true if a heap contains no entries
+ */
+inline bool radix_empty(const radix_heap& h)
+{
+	return h.count == 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file reorder.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of locality-improving vertex reorderings of a graph
+ */
+#pragma once
+
+#include "../include/graph.h"
+#include "../include/csr_graph.h"
+#include "../include/bfs.h"
+#include "../include/dfs.h"
+#include "../include/spanning_tree.h"
+
+#include <vector>
+
+//! order in which vertices of a graph are relabeled
+enum class vertex_order {
+	rcm, //!< reverse Cuthill-McKee, keeps neighbours close to each other, reduces bandwidth
+	degree, //!< descending degree, keeps high-degree vertices together at the front
+	bfs //!< order of discovery of breadth-first searches started at each component's smallest vertex
+};
+
+//! Graph with relabeled vertices together with a mapping between new and original indices
+struct reordered_graph {
+	csr_graph graph; //!< relabeled graph, neighbours of each vertex stored in their original order
+	std::vector<int> new_id; //!< new index of each original vertex
+	std::vector<int> old_id; //!< original index of each new vertex
+};
+
+/**
+ * Computes a permutation of vertices of a graph
+ * @param c: graph whose vertices will be ordered
+ * @param order: kind of an ordering
+ * @return original indices of vertices in their new order
+ */
+std::vector<int> compute_vertex_order(const csr_graph& c, vertex_order order);
+
+/**
+ * Relabels vertices of a graph
+ * @param c: graph to be relabeled
+ * @param order: kind of an ordering
+ * @param r: relabeled graph and a mapping of indices that will be constructed
+ */
+void reorder_graph(const csr_graph& c, vertex_order order, reordered_graph& r);
+
+/**
+ * Relabels vertices of an adjacency list graph
+ * @param g: graph to be relabeled
+ * @param order: kind of an ordering
+ * @param r: relabeled graph and a mapping of indices that will be constructed
+ */
+void reorder_graph(graph& g, vertex_order order, reordered_graph& r);
+
+/**
+ * Breadth-first search on a relabeled graph. The start vertex, callbacks and data use original
+ * indices, and since neighbours keep their order the result is the same as that of bfs on the
+ * original graph.
+ * @param r: relabeled graph
+ * @param start: starting vertex, original index
+ * @param data: data needed to run an algorithm, sized for the original graph
+ */
+void bfs(const reordered_graph& r, int start, bfs_data& data);
+
+/**
+ * Depth-first search on a relabeled graph. The start vertex, callbacks and data use original
+ * indices, and since neighbours keep their order the result is the same as that of dfs on the
+ * original graph.
+ * @param r: relabeled graph
+ * @param start: starting vertex, original index
+ * @param data: data needed to run an algorithm, sized for the original graph
+ */
+void dfs(const reordered_graph& r, int start, dfs_data& data);
+
+/**
+ * Calculate a maximum spanning tree of a relabeled graph using Prim's algorithm with a heap.
+ * Ties are broken and the search falls back to vertex 0 by original indices, so the tree is the
+ * same as that of maximum_spanning_tree on the original graph.
+ * @param r: relabeled graph
+ * @param start: starting vertex, original index
+ * @param data: data needed to run an algorithm, sized for the original graph
+ */
+void maximum_spanning_tree(const reordered_graph& r, int start, mst_data& data);
@@ -0,0 +1,306 @@
+/**
+ * @file result_writer.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of buffered writers of results of graph algorithms in text and binary formats
+ */
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//! Format in which results are written
+enum class result_format {
+	text, //!< human readable lines, the same as the streams would print
+	binary //!< result_header followed by fixed size records
+};
+
+//! Kind of records of a binary result file
+enum class result_kind : uint32_t {
+	tree_edges, //!< (parent, vertex, weight) of every tree edge, in order of vertices
+	parents, //!< parent of every vertex in order of vertices, -1 if it has none
+	events //!< (event, x, y) of every traversal hook in order of calls, y is -1 for vertex events
+};
+
+//! Traversal hook recorded in a binary event stream, stored as a single byte
+enum class traversal_event : uint8_t {
+	vertex_early, //!< process_vertex_early
+	edge, //!< process_edge
+	vertex_late //!< process_vertex_late
+};
+
+//! Header of a binary result file. Records follow it until the end of a file, packed without padding,
+//! with vertices stored as signed integers of vertex_bytes bytes and weights as IEEE floating point
+//! numbers of weight_bytes bytes, in the byte order of the machine that wrote a file.
+struct result_header {
+	char magic[8]; //!< identifies a result file, always "GALRES\r\n"
+	uint32_t version; //!< version of a record layout
+	uint32_t kind; //!< kind of records, one of result_kind
+	uint32_t vertex_bytes; //!< size of a vertex index, 4 or 8
+	uint32_t weight_bytes; //!< size of a weight, 4 or 8, 0 if records have no weights
+};
+
+static const size_t writer_buffer_size = 1 << 20; //!< number of bytes buffered before they are written to a file
+
+//! Writer that collects output in a large buffer and hands it to the kernel in big writes
+struct result_writer {
+	/**
+	 * Creates a writer that is not open
+	 */
+	result_writer();
+
+	result_writer(const result_writer&) = delete;
+	result_writer& operator=(const result_writer&) = delete;
+
+	/**
+	 * Flushes and closes a writer that is still open
+	 */
+	~result_writer();
+
+	int fd; //!< file descriptor written to, -1 if a writer is not open
+	bool owns_fd; //!< true if fd is closed by a writer, false for the standard output
+	bool failed; //!< true if a write failed, further output is dropped
+	std::string path; //!< path of an output file, used in error messages
+	std::vector<char> buffer; //!< buffered output
+	size_t used; //!< number of bytes of buffer holding output
+};
+
+/**
+ * Opens a writer that truncates or creates a file
+ * @param w: writer that is not open
+ * @param path: path of an output file, "-" writes to the standard output
+ * @return true if a file was opened successfuly
+ */
+bool open_writer(result_writer& w, const std::string& path);
+
+/**
+ * Writes buffered output to a file
+ * @param w: open writer
+ */
+void flush_writer(result_writer& w);
+
+/**
+ * Flushes buffered output and closes a file
+ * @param w: open writer
+ * @return true if all output was written successfuly
+ */
+bool close_writer(result_writer& w);
+
+/**
+ * Parses a name of a result format
+ * @param name: "text" or "binary"
+ * @param format: parsed format
+ * @return false if a name is unknown
+ */
+bool parse_result_format(const std::string& name, result_format& format);
+
+/**
+ * Appends bytes that do not fit into the rest of a buffer, flushing it first.
+ * Blocks larger than a buffer are written directly.
+ * @param w: open writer
+ * @param data: bytes to be written
+ * @param n: number of bytes
+ */
+void write_bytes_slow(result_writer& w, const void* data, size_t n);
+
+/**
+ * Appends bytes to a writer
+ * @param w: open writer
+ * @param data: bytes to be written
+ * @param n: number of bytes
+ */
+inline void write_bytes(result_writer& w, const void* data, size_t n)
+{
+	if (w.buffer.size() - w.used < n) {
+		write_bytes_slow(w, data, n);
+		return;
+	}
+
+	std::memcpy(w.buffer.data() + w.used, data, n);
+	w.used += n;
+}
+
+/**
+ * Appends a string literal or any other null terminated string to a writer
+ * @param w: open writer
+ * @param s: string to be written
+ */
+inline void write_text(result_writer& w, const char* s)
+{
+	write_bytes(w, s, std::strlen(s));
+}
+
+/**
+ * Appends a decimal integer to a writer, formatted as a stream would
+ * @param w: open writer
+ * @param x: integer to be written
+ */
+template <typename Integer>
+inline void write_int(result_writer& w, Integer x)
+{
+	char digits[24];
+	char* p = digits + sizeof(digits);
+
+	// the magnitude is taken as unsigned, so the most negative value does not overflow
+	using Unsigned = typename std::make_unsigned<Integer>::type;
+	Unsigned u = static_cast<Unsigned>(x);
+	bool negative = std::is_signed<Integer>::value && x < 0;
+	if (negative)
+		u = Unsigned(0) - u;
+
+	do {
+		*--p = char('0' + u % 10);
+		u /= 10;
+	} while (u != 0);
+
+	if (negative)
+		*--p = '-';
+
+	write_bytes(w, p, digits + sizeof(digits) - p);
+}
+
+/**
+ * Appends a floating point number to a writer, formatted as a stream with default flags would,
+ * that is with at most six significant digits as by %g
+ * @param w: open writer
+ * @param x: number to be written
+ */
+inline void write_double(result_writer& w, double x)
+{
+	char digits[32];
+	std::to_chars_result res = std::to_chars(digits, digits + sizeof(digits), x, std::chars_format::general, 6);
+	write_bytes(w, digits, res.ptr - digits);
+}
+
+/**
+ * Appends a vertex index or a weight to a writer as text, choosing a format by its type
+ * @param w: open writer
+ * @param x: value to be written
+ */
+template <typename T>
+inline void write_value(result_writer& w, T x)
+{
+	if constexpr (std::is_integral<T>::value)
+		write_int(w, x);
+	else
+		write_double(w, x);
+}
+
+/**
+ * Appends a value to a writer in its binary representation
+ * @param w: open writer
+ * @param x: value to be written
+ */
+template <typename T>
+inline void write_raw(result_writer& w, T x)
+{
+	write_bytes(w, &x, sizeof(x));
+}
+
+/**
+ * Writes a header of a binary result file
+ * @param w: open writer
+ * @param kind: kind of records that follow
+ * @param vertex_bytes: size of a vertex index
+ * @param weight_bytes: size of a weight, 0 if records have no weights
+ */
+void write_result_header(result_writer& w, result_kind kind, uint32_t vertex_bytes, uint32_t weight_bytes);
+
+/**
+ * Writes a parent array of a traversal. Text lines are "(parent, vertex)," for every vertex that has a parent,
+ * binary records are parents of all vertices.
+ * @param parent: parent of every vertex, -1 if it has none
+ * @param w: open writer
+ * @param format: format of the output
+ */
+template <typename Vertex>
+void write_parents(const std::vector<Vertex>& parent, result_writer& w, result_format format)
+{
+	if (format == result_format::binary) {
+		write_result_header(w, result_kind::parents, sizeof(Vertex), 0);
+		write_bytes(w, parent.data(), parent.size() * sizeof(Vertex));
+		return;
+	}
+
+	for (size_t i = 0; i < parent.size(); i++) {
+		if (parent[i] != -1) {
+			write_text(w, "(");
+			write_int(w, parent[i]);
+			write_text(w, ", ");
+			write_int(w, i);
+			write_text(w, "),\n");
+		}
+	}
+}
+
+//! Visitor that writes every traversal hook to a writer, in the lines the command line tools print
+//! or as binary event records
+template <typename Vertex>
+struct event_writer {
+	/**
+	 * Creates a visitor that writes events of a traversal
+	 * @param w: open writer
+	 * @param format: format of the output, a binary header is written right away
+	 */
+	event_writer(result_writer& w, result_format format)
+		:w(w), format(format)
+	{
+		if (format == result_format::binary)
+			write_result_header(w, result_kind::events, sizeof(Vertex), 0);
+	}
+
+	/**
+	 * Writes a single binary event record
+	 * @param e: kind of an event
+	 * @param x: first vertex
+	 * @param y: second vertex, -1 for vertex events
+	 */
+	void write_event(traversal_event e, Vertex x, Vertex y)
+	{
+		write_raw(w, e);
+		write_raw(w, x);
+		write_raw(w, y);
+	}
+
+	void process_vertex_early(Vertex v)
+	{
+		if (format == result_format::binary) {
+			write_event(traversal_event::vertex_early, v, -1);
+			return;
+		}
+		write_text(w, "visiting vertex: ");
+		write_int(w, v);
+		write_text(w, "\n");
+	}
+
+	void process_edge(Vertex x, Vertex y)
+	{
+		if (format == result_format::binary) {
+			write_event(traversal_event::edge, x, y);
+			return;
+		}
+		write_text(w, "visiting edge: (");
+		write_int(w, x);
+		write_text(w, ", ");
+		write_int(w, y);
+		write_text(w, ")\n");
+	}
+
+	void process_vertex_late(Vertex v)
+	{
+		if (format == result_format::binary) {
+			write_event(traversal_event::vertex_late, v, -1);
+			return;
+		}
+		write_text(w, "exiting vertex: ");
+		write_int(w, v);
+		write_text(w, "\n");
+	}
+
+	result_writer& w; //!< writer of events
+	result_format format; //!< format of events
+};
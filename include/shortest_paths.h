@@ -0,0 +1,74 @@
+/**
+ * @file shortest_paths.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of single-source shortest paths algorithms
+ */
+#pragma once
+
+#include "../include/graph.h"
+#include "../include/csr_graph.h"
+
+#include <string>
+#include <vector>
+
+//! contains shortest paths from a source vertex after running Dijkstra's algorithm or delta-stepping
+struct sssp_data {
+	/**
+	 * Constucts shortest paths' data
+	 * @param g: graph on which algorithm will run
+	 */
+	sssp_data(graph& g);
+
+	/**
+	 * Constucts shortest paths' data for a compressed sparse row graph
+	 * @param c: graph on which algorithm will run
+	 */
+	sssp_data(const csr_graph& c);
+
+	std::vector<double> distance; //!< a vector that holds a length of a shortest path from a source to each vertex, infinity if not reachable
+	std::vector<int> parent; //!< a vector that holds an index of a previous vertex on a shortest path for each of vertices
+};
+
+/**
+ * Calculate shortest paths from a source vertex using Dijkstra's algorithm with a radix heap
+ * @param g: graph with non-negative edge weights
+ * @param source: starting vertex
+ * @param data: data needed to run an algorithm
+ * @return false if a graph has an edge of negative weight
+ */
+bool dijkstra(graph& g, int source, sssp_data& data);
+
+/**
+ * Calculate shortest paths from a source vertex of a compressed sparse row graph using
+ * Dijkstra's algorithm with a radix heap
+ * @param c: graph with non-negative edge weights
+ * @param source: starting vertex
+ * @param data: data needed to run an algorithm
+ * @return false if a graph has an edge of negative weight
+ */
+bool dijkstra(const csr_graph& c, int source, sssp_data& data);
+
+/**
+ * Calculate shortest paths from a source vertex on multiple threads using delta-stepping.
+ * Vertices are settled in buckets of tentative distances of width delta, all vertices of the
+ * current bucket relax their edges in parallel and improve distances with atomic operations.
+ * Every thread collects improved vertices in its own buckets, which are merged per bucket.
+ * Distances are the same as those of dijkstra. Parents are chosen after distances are final,
+ * as the first neighbour on a shortest path in the order edges are stored.
+ * @param c: graph with non-negative edge weights
+ * @param source: starting vertex
+ * @param data: data needed to run an algorithm
+ * @param delta: width of a bucket, 0 chooses it from the average weight and degree of a graph
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ * @return false if a graph has an edge of negative weight
+ */
+bool delta_stepping(const csr_graph& c, int source, sssp_data& data, double delta = 0,
+	int num_threads = 0);
+
+/**
+ * Prints shortest paths to an output file
+ * @param data: contains shortest paths to be printed
+ * @param file: output file to which shortest paths will be printed
+ * @return true if shortest paths were output to file successfuly
+ */
+bool print_sssp_to_file(const sssp_data& data, const std::string& file);
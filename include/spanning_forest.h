@@ -0,0 +1,53 @@
+/**
+ * @file spanning_forest.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a parallel maximum spanning forest algorithm
+ */
+#pragma once
+
+#include "../include/csr_graph.h"
+#include "../include/external_graph.h"
+#include "../include/spanning_tree.h"
+
+#include <vector>
+
+/**
+ * Calculate a maximum spanning forest of every component of a graph using parallel Borůvka's algorithm.
+ * In every round each component picks its heaviest outgoing edge, then components are merged
+ * along the picked edges with a lock-free union-find. Edges of equal weight are ordered by their
+ * end vertices, so the picked edges never form a cycle.
+ * The forest is returned rooted at the smallest vertex of every component: roots have distance 0
+ * and parent -1, like the starting vertex of maximum_spanning_tree. Unlike Prim's algorithm,
+ * edges of zero and negative weight are also used to connect a component.
+ * @param c: graph on which maximum spanning forest will be calculated
+ * @param data: data constructed for a graph c
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ */
+void maximum_spanning_forest(const csr_graph& c, mst_data& data, int num_threads = 0);
+
+/**
+ * Calculate a maximum spanning forest of every component of a graph by running Prim's algorithm
+ * on all components in parallel. Large components are separate tasks, small ones are batched
+ * together into tasks of a similar size. Every tree is grown from the smallest vertex of its
+ * component, so it is the tree that maximum_spanning_tree started at that vertex produces.
+ * Like maximum_spanning_tree, edges of zero and negative weight are not used.
+ * @param c: graph on which maximum spanning forest will be calculated
+ * @param component: label of each vertex, the smallest vertex of its component, from connected_components
+ * @param data: data constructed for a graph c
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ */
+void component_spanning_forest(const csr_graph& c, const std::vector<int>& component,
+	mst_data& data, int num_threads = 0);
+
+/**
+ * Calculate a maximum spanning forest of a semi-external graph with Borůvka's algorithm.
+ * Every round streams rows of the graph from disk in sequential blocks and picks the heaviest
+ * outgoing edge of every component, only union-find and the picked edges are kept in memory.
+ * A vertex whose edges all lead inside of its component is not read again in later rounds.
+ * The forest is the same as the one of maximum_spanning_forest and is rooted the same way.
+ * The number of bytes read is left in e.bytes_read.
+ * @param e: graph on which maximum spanning forest will be calculated
+ * @param data: data constructed for a graph e
+ * @return false if reading a graph failed
+ */
+bool maximum_spanning_forest(external_graph& e, mst_data& data);
@@ -6,32 +6,112 @@
 #pragma once
 
 #include "../include/graph.h"
+#include "../include/csr_graph.h"
+#include "../include/compressed_graph.h"
+#include "../include/external_graph.h"
+#include "../include/result_writer.h"
 
-//! contains minimum spanning tree after running the Prim's algorithm
-struct mst_data {
+//! strategy used by the Prim's algorithm to pick the next vertex of a spanning tree
+enum class mst_strategy {
+	automatic, //!< chosen from the density of a graph
+	dense, //!< linear scan over all vertices, O(V^2) total, best for dense graphs
+	heap //!< indexed max-heap with increase-key, O(E log V) total, best for sparse graphs
+};
+
+//! contains minimum spanning tree after running the Prim's algorithm, over types of vertex indices and weights
+template <typename Vertex, typename Weight>
+struct basic_mst_data {
 	/**
 	 * Constucts maximum spanning tree's data
 	 * @param g: maximum spanning tree's data to be constructed.
 	 */
-	mst_data(graph& g);
+	basic_mst_data(basic_graph<Vertex, Weight>& g);
+
+	/**
+	 * Constucts maximum spanning tree's data for a compressed sparse row graph
+	 * @param c: graph on which algorithm will run
+	 */
+	basic_mst_data(const csr_graph& c);
+
+	/**
+	 * Constucts maximum spanning tree's data for a compressed graph
+	 * @param z: graph on which algorithm will run
+	 */
+	basic_mst_data(const compressed_graph& z);
+
+	/**
+	 * Constucts maximum spanning tree's data for a semi-external graph
+	 * @param e: graph on which algorithm will run
+	 */
+	basic_mst_data(const external_graph& e);
 
 	std::vector<bool> intree; //!< a vector that information if a given vertex is already in a spanning tree
-	std::vector<double> distance; //!< a vector that information of a weight of a vertex in a spanning tree
-	std::vector<int> parent; //!< a vector that holds an index of a parent vertex for each of vertices
+	std::vector<Weight> distance; //!< a vector that information of a weight of a vertex in a spanning tree
+	std::vector<Vertex> parent; //!< a vector that holds an index of a parent vertex for each of vertices
 };
 
+using mst_data = basic_mst_data<int, double>;
+
 /**
- * Calculate a maximum spanning tree for a given graph using Prim's algorithm
+ * Calculate a maximum spanning tree for a given graph using Prim's algorithm.
+ * Both strategies pick the same vertex at every step, so they produce the same tree.
  * @param g: graph on which minimum spanning tree will be calculated
  * @param start: arbitrary starting index
  * @param data: data needed to run an algorithm
+ * @param strategy: how the next vertex is picked, by default chosen from the density of a graph
+ */
+template <typename Vertex, typename Weight>
+void maximum_spanning_tree(basic_graph<Vertex, Weight>& g, typename basic_graph<Vertex, Weight>::vertex_type start,
+	basic_mst_data<Vertex, Weight>& data, mst_strategy strategy = mst_strategy::automatic);
+
+/**
+ * Calculate a maximum spanning tree for a compressed sparse row graph using Prim's algorithm.
+ * Both strategies pick the same vertex at every step, so they produce the same tree.
+ * @param c: graph on which maximum spanning tree will be calculated
+ * @param start: arbitrary starting index
+ * @param data: data needed to run an algorithm
+ * @param strategy: how the next vertex is picked, by default chosen from the density of a graph
+ */
+void maximum_spanning_tree(const csr_graph& c, int start, mst_data& data,
+	mst_strategy strategy = mst_strategy::automatic);
+
+/**
+ * Calculate a maximum spanning tree for a compressed graph using Prim's algorithm,
+ * decoding neighbour lists on the fly.
+ * Both strategies pick the same vertex at every step, so they produce the same tree.
+ * @param z: graph on which maximum spanning tree will be calculated
+ * @param start: arbitrary starting index
+ * @param data: data needed to run an algorithm
+ * @param strategy: how the next vertex is picked, by default chosen from the density of a graph
+ */
+void maximum_spanning_tree(const compressed_graph& z, int start, mst_data& data,
+	mst_strategy strategy = mst_strategy::automatic);
+
+/**
+ * Sums weights of all edges of a spanning tree or forest
+ * @param data: contains a spanning tree
+ * @return total weight of edges that connect vertices to their parents
+ */
+template <typename Vertex, typename Weight>
+double spanning_tree_weight(const basic_mst_data<Vertex, Weight>& data);
+
+/**
+ * Writes edges of a spanning tree or forest. Text lines are "(parent, vertex, weight),",
+ * binary records are tree edges with weights stored as floats for float weights and as doubles otherwise.
+ * @param data: contains a spanning tree
+ * @param w: open writer
+ * @param format: format of the output
  */
-void maximum_spanning_tree(graph& g, int start, mst_data& data);
+template <typename Vertex, typename Weight>
+void write_mst(const basic_mst_data<Vertex, Weight>& data, result_writer& w, result_format format);
 
 /**
  * Prints a minimum spanning tree to an input file
  * @param data: contains a minimum spanning tree to be printed
- * @param file: output file to which maximum spanning tree will be printed
+ * @param file: output file to which maximum spanning tree will be printed, "-" for the standard output
+ * @param format: format of the output
  * @return true if minimum spanning tree was output to file successfuly
  */
-bool print_mst_to_file(mst_data& data, const std::string& file);
+template <typename Vertex, typename Weight>
+bool print_mst_to_file(basic_mst_data<Vertex, Weight>& data, const std::string& file,
+	result_format format = result_format::text);
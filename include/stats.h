@@ -0,0 +1,148 @@
+/**
+ * @file stats.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of optional counters and timers of algorithm runs
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//! Statistics of a single breadth-first search level
+struct level_stats {
+	size_t frontier = 0; //!< number of vertices at this depth
+	size_t edges = 0; //!< number of half-edges scanned from vertices at this depth
+	double start_us = 0; //!< time when the level was first seen, in microseconds since a run started
+};
+
+//! Time spent in a named part of a run
+struct phase_stats {
+	std::string name; //!< name of a phase
+	double start_us; //!< start of a phase in microseconds since a run started
+	double duration_us; //!< duration of a phase in microseconds
+};
+
+//! Counters collected by algorithms while a stats_scope with this object is active on a thread.
+//! Algorithms fill them only when the library is built with GAL_STATS defined, otherwise every
+//! instrumentation point compiles to nothing and a run leaves the counters at zero.
+struct run_stats {
+	/**
+	 * Creates empty statistics
+	 * @param hardware: true to also read hardware counters with perf_event_open where available
+	 */
+	run_stats(bool hardware = false);
+
+	size_t edges_scanned; //!< number of half-edges examined
+	size_t vertices_discovered; //!< number of vertices reached
+	size_t heap_pushes; //!< number of vertices inserted into a heap
+	size_t heap_increases; //!< number of keys increased in a heap
+	size_t heap_pops; //!< number of vertices removed from a heap
+	size_t scan_steps; //!< number of vertices examined by linear scans of the dense Prim's algorithm
+	std::vector<level_stats> levels; //!< statistics of each breadth-first search level
+	std::vector<phase_stats> phases; //!< timed phases, in order of their start
+
+	bool hardware; //!< true if hardware counters were requested
+	long long cycles; //!< CPU cycles, -1 if not available
+	long long instructions; //!< retired instructions, -1 if not available
+	long long cache_misses; //!< last level cache misses, -1 if not available
+
+	std::chrono::steady_clock::time_point origin; //!< start of a run, set by stats_scope
+};
+
+/**
+ * Returns statistics that algorithms running on the calling thread report to
+ * @return reference to a pointer to active statistics, nullptr if none
+ */
+inline run_stats*& current_stats()
+{
+	static thread_local run_stats* active = nullptr;
+	return active;
+}
+
+/**
+ * Returns the time elapsed since a run started
+ * @param s: statistics of a run
+ * @return time in microseconds
+ */
+double stats_elapsed_us(const run_stats& s);
+
+/**
+ * Returns statistics of a breadth-first search level, creating the levels up to it
+ * @param s: statistics of a run
+ * @param level: depth of a level
+ * @return statistics of a level
+ */
+level_stats& stats_level(run_stats& s, size_t level);
+
+//! Makes statistics active on the calling thread for the lifetime of a scope and, if requested,
+//! measures hardware counters over it. Scopes may be nested, the previous statistics are restored.
+struct stats_scope {
+	/**
+	 * Starts collecting statistics of a run
+	 * @param s: statistics to be filled
+	 */
+	stats_scope(run_stats& s);
+
+	stats_scope(const stats_scope&) = delete;
+	stats_scope& operator=(const stats_scope&) = delete;
+
+	/**
+	 * Stops collecting statistics and reads hardware counters
+	 */
+	~stats_scope();
+
+	run_stats& stats; //!< statistics being filled
+	run_stats* previous; //!< statistics active before this scope
+	int counters[3]; //!< file descriptors of hardware counters, -1 if not opened
+};
+
+//! Adds a phase of a given name to active statistics for the lifetime of a scope
+struct stats_phase_timer {
+	/**
+	 * Starts a phase
+	 * @param s: active statistics, nullptr if none
+	 * @param name: name of a phase
+	 */
+	stats_phase_timer(run_stats* s, const char* name);
+
+	stats_phase_timer(const stats_phase_timer&) = delete;
+	stats_phase_timer& operator=(const stats_phase_timer&) = delete;
+
+	/**
+	 * Ends a phase
+	 */
+	~stats_phase_timer();
+
+	run_stats* stats; //!< active statistics, nullptr if none
+	size_t index; //!< position of a phase in stats->phases
+};
+
+/**
+ * Prints statistics as Chrome trace event JSON, viewable in chrome://tracing or Perfetto.
+ * Phases become complete events, levels and counters become counter events.
+ * @param s: statistics of a run
+ * @param file: output file
+ * @return true if statistics were written successfuly
+ */
+bool print_stats_trace(const run_stats& s, const std::string& file);
+
+#define GAL_STATS_CONCAT_(a, b) a##b
+#define GAL_STATS_CONCAT(a, b) GAL_STATS_CONCAT_(a, b)
+
+#ifdef GAL_STATS
+//! declares a local pointer s to the statistics active on this thread
+#define GAL_STATS_BEGIN(s) run_stats* s = current_stats()
+//! adds n to a counter of active statistics
+#define GAL_STATS_ADD(s, field, n) do { if (s) (s)->field += (n); } while (0)
+//! adds n to a counter of a breadth-first search level
+#define GAL_STATS_LEVEL(s, level, field, n) do { if (s) stats_level(*(s), (level)).field += (n); } while (0)
+//! times the rest of the enclosing scope as a named phase
+#define GAL_STATS_PHASE(s, name) stats_phase_timer GAL_STATS_CONCAT(gal_stats_phase_, __LINE__)((s), (name))
+#else
+#define GAL_STATS_BEGIN(s) ((void)0)
+#define GAL_STATS_ADD(s, field, n) ((void)0)
+#define GAL_STATS_LEVEL(s, level, field, n) ((void)0)
+#define GAL_STATS_PHASE(s, name) ((void)0)
+#endif
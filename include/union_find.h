@@ -0,0 +1,95 @@
+/**
+ * @file union_find.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of a lock-free union-find data structure
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+//! Disjoint sets of vertices that can be found and united from multiple threads without locks.
+//! A root of every set is its vertex with the smallest index.
+struct concurrent_union_find {
+	/**
+	 * Creates n singleton sets
+	 * @param n: number of vertices
+	 */
+	concurrent_union_find(int n);
+
+	int size; //!< number of vertices
+	std::unique_ptr<std::atomic<int>[]> parent; //!< parent of each vertex, roots are their own parents
+};
+
+/**
+ * Finds a root of a set that contains a vertex, halving the path on the way
+ * @param uf: union-find
+ * @param x: index of a vertex
+ * @return index of a root of a set
+ */
+inline int uf_find(concurrent_union_find& uf, int x)
+{
+	while (true) {
+		int p = uf.parent[x].load(std::memory_order_relaxed);
+		if (p == x)
+			return x;
+
+		int gp = uf.parent[p].load(std::memory_order_relaxed);
+		if (gp == p)
+			return p;
+
+		// a failed update only means another thread has already shortened the path
+		uf.parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+		x = gp;
+	}
+}
+
+/**
+ * Unites sets that contain two vertices, linking the root with the greater index under the other
+ * @param uf: union-find
+ * @param x: index of a first vertex
+ * @param y: index of a second vertex
+ * @return true if the sets were different and this call united them
+ */
+inline bool uf_unite(concurrent_union_find& uf, int x, int y)
+{
+	while (true) {
+		x = uf_find(uf, x);
+		y = uf_find(uf, y);
+
+		if (x == y)
+			return false;
+		if (x < y) {
+			int t = x;
+			x = y;
+			y = t;
+		}
+
+		// only a root may be linked, so x must still be its own parent
+		int expected = x;
+		if (uf.parent[x].compare_exchange_strong(expected, y, std::memory_order_acq_rel))
+			return true;
+	}
+}
+
+/**
+ * Checks if two vertices are in the same set
+ * @param uf: union-find
+ * @param x: index of a first vertex
+ * @param y: index of a second vertex
+ * @return true if both vertices are in the same set
+ */
+inline bool uf_same(concurrent_union_find& uf, int x, int y)
+{
+	while (true) {
+		x = uf_find(uf, x);
+		y = uf_find(uf, y);
+
+		if (x == y)
+			return true;
+
+		// x is not linked anywhere yet, so the sets are really different
+		if (uf.parent[x].load(std::memory_order_acquire) == x)
+			return false;
+	}
+}
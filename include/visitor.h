@@ -0,0 +1,14 @@
+/**
+ * @file visitor.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of visitors used by templated graph traversals
+ */
+#pragma once
+
+//! Visitor whose hooks do nothing, traversals with it compile down to the bare loop.
+//! Visitors passed to the templated traversals provide the same three member functions.
+struct null_visitor {
+	void process_vertex_early(int) { }
+	void process_edge(int, int) { }
+	void process_vertex_late(int) { }
+};
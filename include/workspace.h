@@ -0,0 +1,229 @@
+/**
+ * @file workspace.h
+ * @author Jacek Falkowski
+ * @brief File contains declaration of reusable traversal workspaces and a pool of them
+ */
+#pragma once
+
+#include "../include/csr_graph.h"
+#include "../include/dfs.h"
+#include "../include/indexed_heap.h"
+#include "../include/visitor.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//! Per-vertex state of traversals that is reused between runs on the same graph.
+//! A vertex is discovered or processed in the current run only if its stamp equals the current
+//! epoch, so starting a new run does not touch any vertex. Parent, depth and distance of a vertex
+//! are valid only if it is discovered in the current run.
+struct traversal_workspace {
+	/**
+	 * Creates a workspace for graphs with n vertices
+	 * @param n: number of vertices, max_index + 1
+	 */
+	traversal_workspace(int n);
+
+	uint32_t epoch; //!< stamp of the current run
+	std::vector<uint32_t> discovered; //!< epoch in which each vertex was discovered
+	std::vector<uint32_t> processed; //!< epoch in which each vertex was processed
+	std::vector<int> parent; //!< index of a parent vertex of each discovered vertex
+	std::vector<int> depth; //!< distance in edges from a starting vertex of each discovered vertex
+	std::vector<double> distance; //!< weight of a tree edge of each discovered vertex, filled by maximum_spanning_tree
+	std::vector<int> touched; //!< vertices discovered in the current run, in order of discovery
+	std::vector<csr_dfs_frame> stack; //!< storage of a depth-first search stack
+	indexed_heap heap; //!< heap of the Prim's algorithm, empty between runs
+};
+
+/**
+ * Starts a new run, forgetting the previous one in time proportional to the vertices it touched
+ * @param ws: workspace
+ */
+void reset_workspace(traversal_workspace& ws);
+
+/**
+ * Checks if a vertex was discovered in the current run
+ * @param ws: workspace
+ * @param x: index of a vertex
+ * @return true if x was discovered
+ */
+inline bool is_discovered(const traversal_workspace& ws, int x)
+{
+	return ws.discovered[x] == ws.epoch;
+}
+
+/**
+ * Checks if a vertex was processed in the current run
+ * @param ws: workspace
+ * @param x: index of a vertex
+ * @return true if x was processed
+ */
+inline bool is_processed(const traversal_workspace& ws, int x)
+{
+	return ws.processed[x] == ws.epoch;
+}
+
+/**
+ * Marks a vertex as discovered in the current run
+ * @param ws: workspace
+ * @param x: index of a vertex
+ * @param parent: index of a parent vertex, -1 for a starting vertex
+ * @param depth: distance in edges from a starting vertex
+ */
+inline void discover(traversal_workspace& ws, int x, int parent, int depth)
+{
+	ws.discovered[x] = ws.epoch;
+	ws.parent[x] = parent;
+	ws.depth[x] = depth;
+	ws.touched.push_back(x);
+}
+
+/**
+ * Breadth-first search that keeps its state in a workspace. The list of touched vertices
+ * doubles as the queue, since vertices leave a breadth-first search queue in order of discovery.
+ * Hooks are invoked in the same order as in bfs.
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param ws: workspace, reset before the run
+ * @param visitor: object with process_vertex_early, process_edge and process_vertex_late members
+ */
+template <typename Visitor>
+void bfs(const csr_graph& c, int start, traversal_workspace& ws, Visitor&& visitor)
+{
+	reset_workspace(ws);
+	discover(ws, start, -1, 0);
+
+	for (size_t head = 0; head < ws.touched.size(); head++) {
+		int x = ws.touched[head];
+
+		visitor.process_vertex_early(x);
+		ws.processed[x] = ws.epoch;
+
+		for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++) {
+			int y = c.neighbors[i];
+
+			if (!is_processed(ws, y))
+				visitor.process_edge(x, y);
+
+			if (!is_discovered(ws, y))
+				discover(ws, y, x, ws.depth[x] + 1);
+		}
+		visitor.process_vertex_late(x);
+	}
+}
+
+/**
+ * Depth-first search that keeps its state in a workspace.
+ * Hooks are invoked in the same order as in dfs.
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param ws: workspace, reset before the run
+ * @param visitor: object with process_vertex_early, process_edge and process_vertex_late members
+ */
+template <typename Visitor>
+void dfs(const csr_graph& c, int start, traversal_workspace& ws, Visitor&& visitor)
+{
+	reset_workspace(ws);
+	discover(ws, start, -1, 0);
+	visitor.process_vertex_early(start);
+	ws.stack.push_back({ start, c.offsets[start] });
+
+	while (!ws.stack.empty()) {
+		csr_dfs_frame& f = ws.stack.back();
+		int x = f.x;
+
+		size_t end = c.offsets[x + 1];
+		while (f.next < end && is_discovered(ws, c.neighbors[f.next]))
+			f.next++;
+
+		if (f.next == end) {
+			ws.stack.pop_back();
+			ws.processed[x] = ws.epoch;
+			visitor.process_vertex_late(x);
+			continue;
+		}
+
+		int y = c.neighbors[f.next++];
+
+		visitor.process_edge(x, y);
+		discover(ws, y, x, ws.depth[x] + 1);
+		visitor.process_vertex_early(y);
+		ws.stack.push_back({ y, c.offsets[y] });
+	}
+}
+
+/**
+ * Breadth-first search that keeps its state in a workspace, without hooks
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param ws: workspace, reset before the run
+ */
+void bfs(const csr_graph& c, int start, traversal_workspace& ws);
+
+/**
+ * Depth-first search that keeps its state in a workspace, without hooks
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param ws: workspace, reset before the run
+ */
+void dfs(const csr_graph& c, int start, traversal_workspace& ws);
+
+/**
+ * Calculate a maximum spanning tree of the component of a starting vertex using Prim's algorithm
+ * with a heap, keeping its state in a workspace. Vertices in a tree are processed, and their parent
+ * and distance hold the tree edges. Unlike maximum_spanning_tree, the run stops when the component
+ * is spanned and does not continue from vertex 0.
+ * @param c: graph on which maximum spanning tree will be calculated
+ * @param start: starting vertex
+ * @param ws: workspace, reset before the run
+ */
+void maximum_spanning_tree(const csr_graph& c, int start, traversal_workspace& ws);
+
+//! Pool of workspaces from which concurrent query threads check out a workspace each
+struct workspace_pool {
+	/**
+	 * Creates an empty pool for graphs with n vertices, workspaces are created on demand
+	 * @param n: number of vertices, max_index + 1
+	 */
+	workspace_pool(int n);
+
+	int vertices; //!< number of vertices of workspaces in a pool
+	std::mutex lock; //!< guards idle
+	std::vector<std::unique_ptr<traversal_workspace>> idle; //!< workspaces that are not checked out
+};
+
+/**
+ * Checks out a workspace from a pool, creating a new one if all of them are in use
+ * @param pool: pool of workspaces
+ * @return workspace owned by a caller until it is returned with release_workspace
+ */
+std::unique_ptr<traversal_workspace> acquire_workspace(workspace_pool& pool);
+
+/**
+ * Returns a workspace to a pool
+ * @param pool: pool that a workspace was acquired from
+ * @param ws: workspace to be returned
+ */
+void release_workspace(workspace_pool& pool, std::unique_ptr<traversal_workspace> ws);
+
+//! Workspace checked out from a pool for the lifetime of a lease
+struct workspace_lease {
+	/**
+	 * Checks out a workspace
+	 * @param pool: pool of workspaces
+	 */
+	workspace_lease(workspace_pool& pool);
+
+	workspace_lease(const workspace_lease&) = delete;
+	workspace_lease& operator=(const workspace_lease&) = delete;
+
+	/**
+	 * Returns a workspace to its pool
+	 */
+	~workspace_lease();
+
+	workspace_pool& pool; //!< pool that a workspace is returned to
+	std::unique_ptr<traversal_workspace> ws; //!< checked out workspace
+};
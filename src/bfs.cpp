@@ -8,6 +8,8 @@
 #include <algorithm>
 #include <queue>
 #include <functional>
+#include <cstdint>
+#include <vector>
 
 /**
   * Initialize context
@@ -16,7 +18,9 @@
   * @param process_edge: callback invoked when edge is processed
   * @param process_vertex_late: callback invoked when node is lately processed
   */
-bfs_data::bfs_data(graph& g,
+template <typename Vertex>
+template <typename Weight>
+basic_bfs_data<Vertex>::basic_bfs_data(basic_graph<Vertex, Weight>& g,
                 vertex_callback&& process_vertex_early, edge_callback&& process_edge,
                 vertex_callback&& process_vertex_late)
         :process_vertex_early(process_vertex_early),
@@ -24,7 +28,85 @@ bfs_data::bfs_data(graph& g,
          process_vertex_late(process_vertex_late),
          discovered(g.max_index + 1, false),
          processed(g.max_index + 1, false),
-         parent(g.max_index + 1, -1) { }
+         parent(g.max_index + 1, -1),
+         depth(g.max_index + 1, -1) { }
+
+/**
+  * Initialize context for a compressed sparse row graph
+  * @param c: graph on which algorithm will run
+  * @param process_vertex_early: callback invoked when node is initially processed
+  * @param process_edge: callback invoked when edge is processed
+  * @param process_vertex_late: callback invoked when node is lately processed
+  */
+template <typename Vertex>
+basic_bfs_data<Vertex>::basic_bfs_data(const csr_graph& c,
+                vertex_callback&& process_vertex_early, edge_callback&& process_edge,
+                vertex_callback&& process_vertex_late)
+        :process_vertex_early(process_vertex_early),
+         process_edge(process_edge),
+         process_vertex_late(process_vertex_late),
+         discovered(c.max_index + 1, false),
+         processed(c.max_index + 1, false),
+         parent(c.max_index + 1, -1),
+         depth(c.max_index + 1, -1) { }
+
+/**
+  * Initialize context for a traversal with a visitor, callbacks do nothing
+  * @param g: graph on which algorithm will run
+  */
+template <typename Vertex>
+template <typename Weight>
+basic_bfs_data<Vertex>::basic_bfs_data(basic_graph<Vertex, Weight>& g)
+        :basic_bfs_data(g, [] (Vertex) { }, [] (Vertex, Vertex) { }, [] (Vertex) { }) { }
+
+/**
+  * Initialize context for a traversal of a compressed sparse row graph with a visitor,
+  * callbacks do nothing
+  * @param c: graph on which algorithm will run
+  */
+template <typename Vertex>
+basic_bfs_data<Vertex>::basic_bfs_data(const csr_graph& c)
+        :basic_bfs_data(c, [] (Vertex) { }, [] (Vertex, Vertex) { }, [] (Vertex) { }) { }
+
+/**
+  * Initialize context for a traversal of a compressed graph with a visitor,
+  * callbacks do nothing
+  * @param z: graph on which algorithm will run
+  */
+template <typename Vertex>
+basic_bfs_data<Vertex>::basic_bfs_data(const compressed_graph& z)
+        :process_vertex_early([] (Vertex) { }),
+         process_edge([] (Vertex, Vertex) { }),
+         process_vertex_late([] (Vertex) { }),
+         discovered(z.max_index + 1, false),
+         processed(z.max_index + 1, false),
+         parent(z.max_index + 1, -1),
+         depth(z.max_index + 1, -1) { }
+
+/**
+  * Initialize context for a traversal of a semi-external graph with a visitor,
+  * callbacks do nothing
+  * @param e: graph on which algorithm will run
+  */
+template <typename Vertex>
+basic_bfs_data<Vertex>::basic_bfs_data(const external_graph& e)
+        :process_vertex_early([] (Vertex) { }),
+         process_edge([] (Vertex, Vertex) { }),
+         process_vertex_late([] (Vertex) { }),
+         discovered(e.max_index + 1, false),
+         processed(e.max_index + 1, false),
+         parent(e.max_index + 1, -1),
+         depth(e.max_index + 1, -1) { }
+
+//! visitor that forwards hooks to the callbacks stored in bfs_data
+template <typename Vertex>
+struct bfs_callback_visitor {
+    basic_bfs_data<Vertex>& data; //!< data whose callbacks are invoked
+
+    void process_vertex_early(Vertex v) { data.process_vertex_early(v); }
+    void process_edge(Vertex x, Vertex y) { data.process_edge(x, y); }
+    void process_vertex_late(Vertex v) { data.process_vertex_late(v); }
+};
 
 /**
  * Breadth-first search implementation based on Steven S. Skiena "The algorithm design manual".
@@ -32,44 +114,209 @@ bfs_data::bfs_data(graph& g,
  * @param dfs_context: context that algorithm will process
  * @param data: data needed to run an algorithm
  */
-void bfs_impl(graph& g, int start, bfs_data& data)
+template <typename Vertex, typename Weight>
+void bfs(basic_graph<Vertex, Weight>& g, typename basic_graph<Vertex, Weight>::vertex_type start,
+        basic_bfs_data<Vertex>& data)
 {
-    std::queue<int> q;
-    int x;
+    bfs(g, start, data, bfs_callback_visitor<Vertex>{ data });
+}
 
-    q.push(start);
-    data.discovered[start] = true;
+/**
+ * Breadth-first search on a compressed sparse row graph.
+ * Vertices and edges are visited in the same order as on the adjacency list graph it was frozen from.
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ */
+void bfs(const csr_graph& c, int start, bfs_data& data)
+{
+    bfs(c, start, data, bfs_callback_visitor<int>{ data });
+}
 
-    while (!q.empty()) {
-        x = q.front();
-        q.pop();
+/**
+ * Breadth-first search on a compressed graph, decoding neighbour lists on the fly.
+ * Neighbours of each vertex are visited in ascending order.
+ * @param z: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ */
+void bfs(const compressed_graph& z, int start, bfs_data& data)
+{
+    bfs(z, start, data, bfs_callback_visitor<int>{ data });
+}
 
-        data.process_vertex_early(x);
-        data.processed[x] = true;
+/**
+ * Level-synchronous breadth-first search on a semi-external graph. Vertices of every level are sorted
+ * and their rows are streamed from disk in large sequential blocks, so a level costs one pass over
+ * the file instead of a random read per vertex. Depths are the same as of bfs on the graph in memory,
+ * vertices of a level are processed in increasing order, so a parent of a vertex is its smallest
+ * neighbour on the previous level. The number of bytes read is left in e.bytes_read.
+ * @param e: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ * @return false if reading a graph failed
+ */
+bool bfs(external_graph& e, int start, bfs_data& data)
+{
+    return bfs(e, start, data, bfs_callback_visitor<int>{ data });
+}
 
-        for (edge* p = g.edges[x]; p != nullptr; p = p->next) {
-            int y = p->y;
+static const size_t top_down_alpha = 14; //!< switch to bottom-up when frontier edges exceed 1/alpha of unexplored edges
+static const size_t bottom_up_beta = 24; //!< switch back to top-down when the frontier is below 1/beta of vertices
 
-            if (!data.processed[y])
-                data.process_edge(x, y);
+/**
+ * Checks if a bit of a bitmap is set
+ * @param bits: bitmap
+ * @param i: index of a bit
+ * @return true if a bit is set
+ */
+static inline bool test_bit(const std::vector<uint64_t>& bits, int i)
+{
+    return (bits[i >> 6] >> (i & 63)) & 1;
+}
 
-            if (!data.discovered[y]) {
-                data.discovered[y] = true;
-                q.push(y);
-                data.parent[y] = x;
-            }
-        }
-        data.process_vertex_late(x);
-    }
+/**
+ * Sets a bit of a bitmap
+ * @param bits: bitmap
+ * @param i: index of a bit
+ */
+static inline void set_bit(std::vector<uint64_t>& bits, int i)
+{
+    bits[i >> 6] |= uint64_t(1) << (i & 63);
 }
 
 /**
- * Breadth-first search implementation based on Steven S. Skiena "The algorithm design manual".
- * @param x: starting vertex
- * @param dfs_context: context that algorithm will process
+ * Direction-optimizing breadth-first search on a compressed sparse row graph.
+ * Small frontiers are expanded top-down, from the frontier to its neighbours. When the frontier
+ * grows large, each undiscovered vertex searches its own neighbours for a parent in the frontier
+ * instead (bottom-up), which skips most edges on low-diameter graphs.
+ * This is a callback-free fast path: the callbacks of data are not invoked. It fills discovered,
+ * processed, parent and depth. Depths are the same as those of bfs, parents form an equally valid
+ * breadth-first search tree but may differ from those chosen by bfs.
+ * @param c: graph to be traversed
+ * @param start: starting vertex
  * @param data: data needed to run an algorithm
  */
-void bfs(graph& g, int start, bfs_data& data)
+void bfs_direction_optimizing(const csr_graph& c, int start, bfs_data& data)
 {
-    bfs_impl(g, start, data);
+    int n = c.max_index + 1;
+    size_t words = (n + 63) / 64;
+
+    std::vector<uint64_t> visited(words, 0);
+    std::vector<uint64_t> frontier_bits(words, 0);
+    std::vector<uint64_t> next_bits(words, 0);
+    std::vector<int> frontier;
+    std::vector<int> next;
+
+    // the frontier is kept either as a list (top-down) or as a bitmap (bottom-up)
+    bool bottom_up = false;
+    size_t frontier_size = 1;
+    size_t frontier_edges = degree(c, start);
+    size_t unexplored_edges = edge_count(c) - degree(c, start);
+    int level = 0;
+
+    GAL_STATS_BEGIN(stats);
+    GAL_STATS_PHASE(stats, "bfs direction-optimizing");
+
+    set_bit(visited, start);
+    data.parent[start] = -1;
+    data.depth[start] = 0;
+    frontier.push_back(start);
+    GAL_STATS_ADD(stats, vertices_discovered, 1);
+    GAL_STATS_LEVEL(stats, 0, frontier, 1);
+
+    while (frontier_size > 0) {
+        if (!bottom_up && frontier_edges > unexplored_edges / top_down_alpha) {
+            bottom_up = true;
+            std::fill(frontier_bits.begin(), frontier_bits.end(), 0);
+            for (int x : frontier)
+                set_bit(frontier_bits, x);
+        } else if (bottom_up && frontier_size < (size_t)n / bottom_up_beta) {
+            bottom_up = false;
+            frontier.clear();
+            for (int x = 0; x < n; x++) {
+                if (test_bit(frontier_bits, x))
+                    frontier.push_back(x);
+            }
+        }
+
+        GAL_STATS_PHASE(stats, bottom_up ? "bottom-up level" : "top-down level");
+
+        level++;
+        frontier_size = 0;
+        frontier_edges = 0;
+
+        if (bottom_up) {
+            std::fill(next_bits.begin(), next_bits.end(), 0);
+
+            for (int y = 0; y < n; y++) {
+                if (test_bit(visited, y))
+                    continue;
+
+                size_t i = c.offsets[y];
+                for (; i < c.offsets[y + 1]; i++) {
+                    int x = c.neighbors[i];
+
+                    if (test_bit(frontier_bits, x)) {
+                        set_bit(visited, y);
+                        set_bit(next_bits, y);
+                        data.parent[y] = x;
+                        data.depth[y] = level;
+                        frontier_size++;
+                        frontier_edges += degree(c, y);
+                        i++;
+                        break;
+                    }
+                }
+                GAL_STATS_ADD(stats, edges_scanned, i - c.offsets[y]);
+                GAL_STATS_LEVEL(stats, level - 1, edges, i - c.offsets[y]);
+            }
+            frontier_bits.swap(next_bits);
+        } else {
+            next.clear();
+
+            for (int x : frontier) {
+                GAL_STATS_ADD(stats, edges_scanned, degree(c, x));
+                GAL_STATS_LEVEL(stats, level - 1, edges, degree(c, x));
+
+                for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++) {
+                    int y = c.neighbors[i];
+
+                    if (!test_bit(visited, y)) {
+                        set_bit(visited, y);
+                        data.parent[y] = x;
+                        data.depth[y] = level;
+                        next.push_back(y);
+                        frontier_edges += degree(c, y);
+                    }
+                }
+            }
+            frontier.swap(next);
+            frontier_size = frontier.size();
+        }
+
+        unexplored_edges -= std::min(unexplored_edges, frontier_edges);
+        GAL_STATS_ADD(stats, vertices_discovered, frontier_size);
+        if (frontier_size > 0)
+            GAL_STATS_LEVEL(stats, level, frontier, frontier_size);
+    }
+
+    for (int x = 0; x < n; x++) {
+        if (test_bit(visited, x)) {
+            data.discovered[x] = true;
+            data.processed[x] = true;
+        }
+    }
 }
+
+template struct basic_bfs_data<int>;
+template struct basic_bfs_data<int64_t>;
+
+//! instantiates breadth-first search on an adjacency list graph for a type of vertex indices and a type of weights
+#define GAL_INSTANTIATE_BFS(V, W) \
+    template basic_bfs_data<V>::basic_bfs_data(basic_graph<V, W>&, basic_bfs_data<V>::vertex_callback&&, \
+        basic_bfs_data<V>::edge_callback&&, basic_bfs_data<V>::vertex_callback&&); \
+    template basic_bfs_data<V>::basic_bfs_data(basic_graph<V, W>&); \
+    template void bfs<V, W>(basic_graph<V, W>&, V, basic_bfs_data<V>&);
+
+GAL_GRAPH_TYPES(GAL_INSTANTIATE_BFS)
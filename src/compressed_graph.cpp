@@ -0,0 +1,78 @@
+/**
+ * @file compressed_graph.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a read-only graph with delta and varint encoded neighbour lists
+ */
+#include "../include/compressed_graph.h"
+
+#include <algorithm>
+#include <utility>
+
+/**
+ * Creates a new instance of an empty compressed graph
+ */
+compressed_graph::compressed_graph()
+	:max_index(-1), edge_offsets(1, 0), byte_offsets(1, 0)
+{
+}
+
+/**
+ * Appends a varint to a buffer
+ * @param bytes: buffer
+ * @param value: value to be encoded
+ */
+static void write_varint(std::vector<uint8_t>& bytes, uint32_t value)
+{
+	while (value >= 0x80) {
+		bytes.push_back((uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+	bytes.push_back((uint8_t)value);
+}
+
+/**
+ * Builds a compressed graph from a compressed sparse row graph
+ * @param c: graph to be compressed
+ * @param z: compressed graph that will be constructed
+ */
+void compress_graph(const csr_graph& c, compressed_graph& z)
+{
+	int n = c.max_index + 1;
+
+	z.max_index = c.max_index;
+	z.edge_offsets.assign(c.offsets, c.offsets + n + 1);
+	z.byte_offsets.assign(n + 1, 0);
+	z.bytes.clear();
+	z.weights.resize(edge_count(c));
+
+	std::vector<std::pair<int, double>> row;
+
+	for (int x = 0; x < n; x++) {
+		row.clear();
+		for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++)
+			row.emplace_back(c.neighbors[i], c.weights[i]);
+
+		// parallel edges keep their relative order, so their weights are stored as in c
+		std::stable_sort(row.begin(), row.end(), [] (const std::pair<int, double>& a,
+			const std::pair<int, double>& b) { return a.first < b.first; });
+
+		size_t k = c.offsets[x];
+		int previous = x;
+
+		for (size_t i = 0; i < row.size(); i++) {
+			if (i == 0) {
+				uint32_t diff = (uint32_t)row[i].first - (uint32_t)x;
+				write_varint(z.bytes, (diff << 1) ^ (0u - (diff >> 31)));
+			} else {
+				write_varint(z.bytes, (uint32_t)(row[i].first - previous));
+			}
+
+			previous = row[i].first;
+			z.weights[k++] = row[i].second;
+		}
+
+		z.byte_offsets[x + 1] = z.bytes.size();
+	}
+
+	z.bytes.shrink_to_fit();
+}
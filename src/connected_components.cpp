@@ -0,0 +1,121 @@
+/**
+ * @file connected_components.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a parallel connected components algorithm
+ */
+#include "../include/connected_components.h"
+#include "../include/parallel.h"
+#include "../include/union_find.h"
+
+#include <algorithm>
+#include <random>
+
+static const size_t vertex_grain = 1024; //!< number of vertices processed by a thread at once
+static const size_t sampled_neighbours = 2; //!< number of first neighbours united with every vertex
+static const int component_samples = 1024; //!< number of vertices sampled to find the largest component
+
+/**
+ * Points every vertex directly at the root of its set. No sets may be united at the same time.
+ * @param uf: union-find
+ * @param threads: number of threads to use
+ */
+static void compress(concurrent_union_find& uf, int threads)
+{
+	parallel_for(0, uf.size, vertex_grain, [&] (size_t begin, size_t end, int) {
+		for (size_t x = begin; x < end; x++)
+			uf.parent[x].store(uf_find(uf, (int)x), std::memory_order_relaxed);
+	}, threads);
+}
+
+/**
+ * Estimates the largest component from labels of randomly sampled vertices
+ * @param uf: compressed union-find
+ * @return root of the most frequent set among the samples
+ */
+static int largest_component(concurrent_union_find& uf)
+{
+	// a fixed seed keeps the amount of work the same on every run
+	std::mt19937 rng(0);
+	std::uniform_int_distribution<int> vertex(0, uf.size - 1);
+	std::vector<int> samples(component_samples);
+
+	for (int& s : samples)
+		s = uf_find(uf, vertex(rng));
+	std::sort(samples.begin(), samples.end());
+
+	int best = samples[0];
+	size_t best_count = 0;
+
+	for (size_t i = 0; i < samples.size(); ) {
+		size_t j = i;
+		while (j < samples.size() && samples[j] == samples[i])
+			j++;
+
+		if (j - i > best_count) {
+			best = samples[i];
+			best_count = j - i;
+		}
+		i = j;
+	}
+
+	return best;
+}
+
+/**
+ * Labels connected components of a graph on multiple threads using the Afforest algorithm.
+ * First every vertex is united with its first few neighbours, which already merges most of
+ * the largest component. The largest component is then estimated from a sample of vertices,
+ * and only vertices outside of it process their remaining edges.
+ * Sets are united with a lock-free union-find, so the label of every vertex is the smallest
+ * vertex of its component.
+ * @param c: graph whose components will be labeled
+ * @param component: label of each vertex that will be filled
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ * @return number of components, isolated vertices included
+ */
+int connected_components(const csr_graph& c, std::vector<int>& component, int num_threads)
+{
+	int n = c.max_index + 1;
+	int threads = parallel_thread_count(num_threads);
+
+	component.assign(n, -1);
+	if (n == 0)
+		return 0;
+
+	concurrent_union_find uf(n);
+
+	for (size_t r = 0; r < sampled_neighbours; r++) {
+		parallel_for(0, n, vertex_grain, [&] (size_t begin, size_t end, int) {
+			for (size_t x = begin; x < end; x++) {
+				if (degree(c, (int)x) > r)
+					uf_unite(uf, (int)x, c.neighbors[c.offsets[x] + r]);
+			}
+		}, threads);
+		compress(uf, threads);
+	}
+
+	int giant = largest_component(uf);
+
+	// every edge is stored in both directions, so an edge between the largest component and
+	// another vertex is still processed from the side of that vertex
+	parallel_for(0, n, vertex_grain, [&] (size_t begin, size_t end, int) {
+		for (size_t x = begin; x < end; x++) {
+			if (uf_find(uf, (int)x) == giant)
+				continue;
+
+			for (size_t i = c.offsets[x] + sampled_neighbours; i < c.offsets[x + 1]; i++)
+				uf_unite(uf, (int)x, c.neighbors[i]);
+		}
+	}, threads);
+
+	compress(uf, threads);
+
+	int count = 0;
+	for (int x = 0; x < n; x++) {
+		component[x] = uf.parent[x].load(std::memory_order_relaxed);
+		if (component[x] == x)
+			count++;
+	}
+
+	return count;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file csr_graph.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of an immutable compressed sparse row graph data structure
+ */
+#include "../include/csr_graph.h"
+
+#include <algorithm>
+#include <utility>
+
+/**
+ * Creates a new instance of an empty compressed sparse row graph
+ */
+csr_graph::csr_graph()
+	:offsets(nullptr), neighbors(nullptr), weights(nullptr),
+	 max_index(-1), offset_storage(1, 0)
+{
+	attach_storage(*this);
+}
+
+/**
+ * Takes over arrays of another graph
+ * @param other: graph to be moved from
+ */
+csr_graph::csr_graph(csr_graph&& other) noexcept
+	:csr_graph()
+{
+	*this = std::move(other);
+}
+
+/**
+ * Takes over arrays of another graph, releasing the current ones
+ * @param other: graph to be moved from
+ */
+csr_graph& csr_graph::operator=(csr_graph&& other) noexcept
+{
+	if (this != &other) {
+		// moving vectors and a mapping keeps their data in place, so the pointers stay valid
+		offsets = other.offsets;
+		neighbors = other.neighbors;
+		weights = other.weights;
+		max_index = other.max_index;
+		offset_storage = std::move(other.offset_storage);
+		neighbor_storage = std::move(other.neighbor_storage);
+		weight_storage = std::move(other.weight_storage);
+		snapshot = std::move(other.snapshot);
+
+		other.max_index = -1;
+		other.offset_storage.assign(1, 0);
+		other.neighbor_storage.clear();
+		other.weight_storage.clear();
+		attach_storage(other);
+	}
+	return *this;
+}
+
+/**
+ * Points arrays of a graph at its own storage, after the storage was filled
+ * @param c: compressed sparse row graph
+ */
+void attach_storage(csr_graph& c)
+{
+	unmap_file(c.snapshot);
+	c.offsets = c.offset_storage.data();
+	c.neighbors = c.neighbor_storage.data();
+	c.weights = c.weight_storage.data();
+}
+
+/**
+ * Builds a compressed sparse row graph from a populated adjacency list graph.
+ * Neighbours of each vertex are stored in the same order as in the adjacency list,
+ * so traversals visit vertices and edges in the same order on both structures.
+ * @param g: adjacency list graph to be frozen
+ * @param c: compressed sparse row graph that will be constructed
+ */
+void freeze_graph(graph& g, csr_graph& c)
+{
+	size_t n = g.max_index + 1;
+	size_t m = 0;
+
+	c.max_index = g.max_index;
+	c.offset_storage.assign(n + 1, 0);
+
+	for (size_t i = 0; i < n; i++) {
+		for (edge* p = g.edges[i]; p != nullptr; p = p->next)
+			m++;
+		c.offset_storage[i + 1] = m;
+	}
+
+	c.neighbor_storage.resize(m);
+	c.weight_storage.resize(m);
+
+	size_t k = 0;
+	for (size_t i = 0; i < n; i++) {
+		for (edge* p = g.edges[i]; p != nullptr; p = p->next) {
+			c.neighbor_storage[k] = p->y;
+			c.weight_storage[k] = p->weight;
+			k++;
+		}
+	}
+
+	attach_storage(c);
+}
+
+/**
+ * Builds a compressed sparse row graph directly from a list of undirected edges.
+ * The result is the same as inserting the edges with add_edge and calling freeze_graph.
+ * @param edges: list of undirected edges
+ * @param c: compressed sparse row graph that will be constructed
+ */
+void csr_from_edges(const std::vector<weighted_edge>& edges, csr_graph& c)
+{
+	int max_index = -1;
+	for (const weighted_edge& e : edges)
+		max_index = std::max(max_index, std::max(e.x, e.y));
+
+	size_t n = max_index + 1;
+
+	c.max_index = max_index;
+	c.offset_storage.assign(n + 1, 0);
+
+	for (const weighted_edge& e : edges) {
+		c.offset_storage[e.x + 1]++;
+		c.offset_storage[e.y + 1]++;
+	}
+	for (size_t i = 0; i < n; i++)
+		c.offset_storage[i + 1] += c.offset_storage[i];
+
+	c.neighbor_storage.resize(c.offset_storage[n]);
+	c.weight_storage.resize(c.offset_storage[n]);
+
+	// add_edge inserts at the front of a list, so edges are scattered
+	// from the end of each row to keep the adjacency list order
+	std::vector<size_t> cursor(c.offset_storage.begin() + 1, c.offset_storage.end());
+
+	for (const weighted_edge& e : edges) {
+		size_t i = --cursor[e.x];
+		c.neighbor_storage[i] = e.y;
+		c.weight_storage[i] = e.weight;
+
+		size_t j = --cursor[e.y];
+		c.neighbor_storage[j] = e.x;
+		c.weight_storage[j] = e.weight;
+	}
+
+	attach_storage(c);
+}
+
+/*
+ * Print a compressed sparse row graph.
+ * @param c: graph to be printed
+ */
+void print_graph(const csr_graph& c)
+{
+	for (int x = 0; x <= c.max_index; x++) {
+		if (degree(c, x) == 0)
+			continue;
+
+		std::cout << x << ": ";
+		for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++)
+			std::cout << "(" << c.neighbors[i] << ", " << c.weights[i] << ") -> ";
+
+		std::cout << "null" << std::endl;
+	}
+}
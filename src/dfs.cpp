@@ -16,7 +16,9 @@
   * @param process_edge: callback invoked when edge is processed
   * @param process_vertex_late: callback invoked when node is lately processed
   */
-dfs_data::dfs_data(graph& g,
+template <typename Vertex>
+template <typename Weight>
+basic_dfs_data<Vertex>::basic_dfs_data(basic_graph<Vertex, Weight>& g,
                 vertex_callback&& process_vertex_early, edge_callback&& process_edge,
                 vertex_callback&& process_vertex_late)
         :process_vertex_early(process_vertex_early),
@@ -26,38 +28,85 @@ dfs_data::dfs_data(graph& g,
          processed(g.max_index + 1, false),
          parent(g.max_index + 1, -1) { }
 
+/**
+  * Initialize context for a compressed sparse row graph
+  * @param c: graph on which algorithm will run
+  * @param process_vertex_early: callback invoked when node is initially processed
+  * @param process_edge: callback invoked when edge is processed
+  * @param process_vertex_late: callback invoked when node is lately processed
+  */
+template <typename Vertex>
+basic_dfs_data<Vertex>::basic_dfs_data(const csr_graph& c,
+                vertex_callback&& process_vertex_early, edge_callback&& process_edge,
+                vertex_callback&& process_vertex_late)
+        :process_vertex_early(process_vertex_early),
+         process_edge(process_edge),
+         process_vertex_late(process_vertex_late),
+         discovered(c.max_index + 1, false),
+         processed(c.max_index + 1, false),
+         parent(c.max_index + 1, -1) { }
+
+/**
+  * Initialize context for a traversal with a visitor, callbacks do nothing
+  * @param g: graph on which algorithm will run
+  */
+template <typename Vertex>
+template <typename Weight>
+basic_dfs_data<Vertex>::basic_dfs_data(basic_graph<Vertex, Weight>& g)
+        :basic_dfs_data(g, [] (Vertex) { }, [] (Vertex, Vertex) { }, [] (Vertex) { }) { }
+
+/**
+  * Initialize context for a traversal of a compressed sparse row graph with a visitor,
+  * callbacks do nothing
+  * @param c: graph on which algorithm will run
+  */
+template <typename Vertex>
+basic_dfs_data<Vertex>::basic_dfs_data(const csr_graph& c)
+        :basic_dfs_data(c, [] (Vertex) { }, [] (Vertex, Vertex) { }, [] (Vertex) { }) { }
+
+//! visitor that forwards hooks to the callbacks stored in dfs_data
+template <typename Vertex>
+struct dfs_callback_visitor {
+    basic_dfs_data<Vertex>& data; //!< data whose callbacks are invoked
+
+    void process_vertex_early(Vertex v) { data.process_vertex_early(v); }
+    void process_edge(Vertex x, Vertex y) { data.process_edge(x, y); }
+    void process_vertex_late(Vertex v) { data.process_vertex_late(v); }
+};
+
 /**
  * Depth-first search implementation based on Steven S. Skiena "The algorithm design manual".
  * @param x: starting vertex
  * @param dfs_context: context that algorithm will process
  * @param data: data needed to run an algorithm
  */
-void dfs_impl(graph& g, int x, dfs_data& data)
+template <typename Vertex, typename Weight>
+void dfs(basic_graph<Vertex, Weight>& g, typename basic_graph<Vertex, Weight>::vertex_type start,
+        basic_dfs_data<Vertex>& data)
 {
-    data.discovered[x] = true;
-    data.process_vertex_early(x);
-
-    for (edge* p = g.edges[x]; p != nullptr; p = p->next) {
-        int y = p->y;
-
-        if (!data.discovered[y]) {
-            data.parent[y] = x;
-            data.process_edge(x, y);
-            dfs_impl(g, y, data);
-        }
-    }
-
-    data.processed[x] = true;
-    data.process_vertex_late(x);
+    dfs(g, start, data, dfs_callback_visitor<Vertex>{ data });
 }
 
 /**
- * Depth-first search implementation based on Steven S. Skiena "The algorithm design manual".
- * @param x: starting vertex
- * @param dfs_context: context that algorithm will process
+ * Depth-first search on a compressed sparse row graph.
+ * Vertices and edges are visited in the same order as on the adjacency list graph it was frozen from.
+ * @param c: graph to be traversed
+ * @param start: starting vertex
  * @param data: data needed to run an algorithm
  */
-void dfs(graph& g, int start, dfs_data& data)
+void dfs(const csr_graph& c, int start, dfs_data& data)
 {
-    dfs_impl(g, start, data);
+    dfs(c, start, data, dfs_callback_visitor<int>{ data });
 }
+
+template struct basic_dfs_data<int>;
+template struct basic_dfs_data<int64_t>;
+
+//! instantiates depth-first search on an adjacency list graph for a type of vertex indices and a type of weights
+#define GAL_INSTANTIATE_DFS(V, W) \
+    template basic_dfs_data<V>::basic_dfs_data(basic_graph<V, W>&, basic_dfs_data<V>::vertex_callback&&, \
+        basic_dfs_data<V>::edge_callback&&, basic_dfs_data<V>::vertex_callback&&); \
+    template basic_dfs_data<V>::basic_dfs_data(basic_graph<V, W>&); \
+    template void dfs<V, W>(basic_graph<V, W>&, V, basic_dfs_data<V>&);
+
+GAL_GRAPH_TYPES(GAL_INSTANTIATE_DFS)
@@ -0,0 +1,183 @@
+/**
+ * @file external_graph.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a semi-external graph whose edges stay in a snapshot file on disk
+ */
+#include "../include/external_graph.h"
+#include "../include/graph_snapshot.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * Creates a graph that is not open
+ */
+external_graph::external_graph()
+	:fd(-1), max_index(-1), edges(0), neighbors_position(0), weights_position(0),
+	 block_edges(default_external_block / sizeof(int32_t)), bytes_read(0), reads(0)
+{
+}
+
+/**
+ * Closes a snapshot file
+ */
+external_graph::~external_graph()
+{
+	if (fd >= 0)
+		close(fd);
+}
+
+/**
+ * Reads exactly n bytes at a position of a file, counting them in statistics of a graph
+ * @param e: graph
+ * @param buffer: destination of n bytes
+ * @param n: number of bytes
+ * @param position: position in a file
+ * @return false if a file ended or a read failed
+ */
+static bool read_at(external_graph& e, void* buffer, size_t n, uint64_t position)
+{
+	char* p = static_cast<char*>(buffer);
+
+	while (n > 0) {
+		ssize_t got = pread(e.fd, p, n, position);
+		if (got < 0 && errno == EINTR)
+			continue;
+
+		if (got <= 0) {
+			std::cerr << "Error: error while reading input file: " << e.path << std::endl;
+			return false;
+		}
+
+		e.bytes_read += got;
+		e.reads++;
+		p += got;
+		n -= got;
+		position += got;
+	}
+	return true;
+}
+
+/**
+ * Opens a binary graph snapshot for semi-external algorithms. The header is validated and offsets
+ * are read into memory, the rest of a file is left on disk and is not checksummed, neighbours are
+ * range checked as their blocks are read instead.
+ * @param path: path to a snapshot written by save_graph_binary
+ * @param e: graph that will be backed by a file
+ * @param block_bytes: number of bytes of neighbours read at once
+ * @return true if a snapshot was opened successfuly
+ */
+bool open_external_graph(const std::string& path, external_graph& e, size_t block_bytes)
+{
+	if (e.fd >= 0)
+		close(e.fd);
+
+	e.path = path;
+	e.fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (e.fd < 0) {
+		std::cerr << "Error: cannot open input file: " << path << std::endl;
+		return false;
+	}
+
+	struct stat st;
+	snapshot_header header;
+
+	if (fstat(e.fd, &st) != 0 || (uint64_t)st.st_size < sizeof(header)) {
+		std::cerr << "Error: invalid graph snapshot: " << path << std::endl;
+		return false;
+	}
+
+	reset_external_stats(e);
+	if (!read_at(e, &header, sizeof(header), 0) || !check_snapshot_header(header, st.st_size, path))
+		return false;
+
+	e.offsets.resize(header.vertex_count + 1);
+	if (!read_at(e, e.offsets.data(), e.offsets.size() * sizeof(uint64_t), sizeof(header)))
+		return false;
+
+	// rows are read at their offsets, so they must lie inside of the arrays in order
+	for (uint64_t x = 0; x < header.vertex_count; x++) {
+		if (e.offsets[x] > e.offsets[x + 1]) {
+			std::cerr << "Error: invalid graph snapshot: " << path << std::endl;
+			return false;
+		}
+	}
+
+	if (e.offsets[0] != 0 || e.offsets[header.vertex_count] != header.edge_count) {
+		std::cerr << "Error: invalid graph snapshot: " << path << std::endl;
+		return false;
+	}
+
+	e.max_index = (int)(header.vertex_count - 1);
+	e.edges = header.edge_count;
+	e.neighbors_position = snapshot_neighbors_offset(header);
+	e.weights_position = snapshot_weights_offset(header);
+	e.block_edges = std::max<size_t>(1, block_bytes / sizeof(int32_t));
+
+	// blocks are read front to back within every pass over the rows
+	posix_fadvise(e.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+	return true;
+}
+
+/**
+ * Resets counters of bytes and reads, called at the beginning of every run
+ * @param e: graph
+ */
+void reset_external_stats(external_graph& e)
+{
+	e.bytes_read = 0;
+	e.reads = 0;
+}
+
+/**
+ * Reads a block of half-edges starting at a given one, at most block_edges long, checks that every
+ * neighbour is a vertex of a graph and hints the kernel to read ahead the block that follows it
+ * @param e: graph
+ * @param first: index of the first half-edge to read
+ * @param last: index past the last half-edge that a caller needs, the block may end earlier or later
+ * @param with_weights: true to read weights as well as neighbours
+ * @param block: block that receives half-edges
+ * @return false if a read failed or a neighbour is not a vertex of a graph
+ */
+bool read_external_block(external_graph& e, uint64_t first, uint64_t last, bool with_weights, external_block& block)
+{
+	last = std::min<uint64_t>({ last, first + e.block_edges, e.edges });
+	size_t n = (size_t)(last - first);
+	bool sequential = first == block.last;
+
+	block.first = first;
+	block.last = first;
+	block.neighbors.resize(n);
+	block.weights.resize(with_weights ? n : 0);
+
+	if (!read_at(e, block.neighbors.data(), n * sizeof(int32_t), e.neighbors_position + first * sizeof(int32_t)))
+		return false;
+	if (with_weights && !read_at(e, block.weights.data(), n * sizeof(double), e.weights_position + first * sizeof(double)))
+		return false;
+
+	// arrays are not checksummed, so a corrupt neighbour must not index per-vertex state of a caller
+	for (int32_t y : block.neighbors) {
+		if (y < 0 || y > e.max_index) {
+			std::cerr << "Error: invalid graph snapshot: " << e.path << std::endl;
+			return false;
+		}
+	}
+
+	block.last = last;
+
+	// a run of adjacent blocks is a sequential scan, so the next block is worth fetching early
+	if (sequential && last < e.edges) {
+		uint64_t ahead = std::min<uint64_t>(e.block_edges, e.edges - last);
+		posix_fadvise(e.fd, e.neighbors_position + last * sizeof(int32_t), ahead * sizeof(int32_t), POSIX_FADV_WILLNEED);
+		if (with_weights)
+			posix_fadvise(e.fd, e.weights_position + last * sizeof(double), ahead * sizeof(double), POSIX_FADV_WILLNEED);
+	}
+
+	return true;
+}
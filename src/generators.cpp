@@ -0,0 +1,179 @@
+/**
+ * @file generators.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of seeded generators of synthetic graphs
+ */
+#include "../include/generators.h"
+
+#include <iostream>
+#include <random>
+
+static const double rmat_a = 0.57; //!< probability of the upper left quadrant, Graph500 parameters
+static const double rmat_b = 0.19; //!< probability of the upper right quadrant
+static const double rmat_c = 0.19; //!< probability of the lower left quadrant
+
+/**
+ * Draws a weight of an edge
+ * @param rng: random number generator
+ * @return weight from [0, 100)
+ */
+static double random_weight(std::mt19937_64& rng)
+{
+	return std::uniform_real_distribution<double>(0, 100)(rng);
+}
+
+/**
+ * Generates a recursive matrix (R-MAT) graph, a Kronecker-like power-law graph used by Graph500.
+ * Every edge picks one quadrant of the adjacency matrix per bit of a vertex index.
+ * @param scale: logarithm of a number of vertices
+ * @param edge_factor: number of edges per vertex
+ * @param seed: seed of a random number generator
+ * @return list of 2^scale * edge_factor edges, self-loops and duplicates included
+ */
+std::vector<weighted_edge> rmat_edges(int scale, int edge_factor, uint64_t seed)
+{
+	std::mt19937_64 rng(seed);
+	std::uniform_real_distribution<double> coin(0, 1);
+	std::vector<weighted_edge> edges((size_t(1) << scale) * edge_factor);
+
+	for (weighted_edge& e : edges) {
+		int x = 0;
+		int y = 0;
+
+		for (int bit = 0; bit < scale; bit++) {
+			double p = coin(rng);
+
+			if (p >= rmat_a + rmat_b + rmat_c) {
+				x |= 1 << bit;
+				y |= 1 << bit;
+			} else if (p >= rmat_a + rmat_b) {
+				x |= 1 << bit;
+			} else if (p >= rmat_a) {
+				y |= 1 << bit;
+			}
+		}
+
+		e = { x, y, random_weight(rng) };
+	}
+
+	return edges;
+}
+
+/**
+ * Generates an Erdos-Renyi G(n, m) graph with uniformly random endpoints
+ * @param vertices: number of vertices
+ * @param edges: number of edges
+ * @param seed: seed of a random number generator
+ * @return list of edges, self-loops and duplicates included
+ */
+std::vector<weighted_edge> erdos_renyi_edges(int vertices, size_t edges, uint64_t seed)
+{
+	std::mt19937_64 rng(seed);
+	std::uniform_int_distribution<int> vertex(0, vertices - 1);
+	std::vector<weighted_edge> result(edges);
+
+	for (weighted_edge& e : result) {
+		int x = vertex(rng);
+		int y = vertex(rng);
+		e = { x, y, random_weight(rng) };
+	}
+
+	return result;
+}
+
+/**
+ * Generates a two-dimensional grid where every vertex is connected to its right and lower neighbour
+ * @param rows: number of rows
+ * @param cols: number of columns
+ * @param seed: seed of a random number generator
+ * @return list of edges, vertex at row r and column c has index r * cols + c
+ */
+std::vector<weighted_edge> grid_edges(int rows, int cols, uint64_t seed)
+{
+	std::mt19937_64 rng(seed);
+	std::vector<weighted_edge> edges;
+	edges.reserve(2 * (size_t)rows * cols);
+
+	for (int r = 0; r < rows; r++) {
+		for (int c = 0; c < cols; c++) {
+			int x = r * cols + c;
+
+			if (c + 1 < cols)
+				edges.push_back({ x, x + 1, random_weight(rng) });
+			if (r + 1 < rows)
+				edges.push_back({ x, x + cols, random_weight(rng) });
+		}
+	}
+
+	return edges;
+}
+
+/**
+ * Generates a path 0 - 1 - ... - (n - 1)
+ * @param vertices: number of vertices
+ * @param seed: seed of a random number generator
+ * @return list of n - 1 edges
+ */
+std::vector<weighted_edge> path_edges(int vertices, uint64_t seed)
+{
+	std::mt19937_64 rng(seed);
+	std::vector<weighted_edge> edges;
+	edges.reserve(vertices);
+
+	for (int x = 0; x + 1 < vertices; x++)
+		edges.push_back({ x, x + 1, random_weight(rng) });
+
+	return edges;
+}
+
+/**
+ * Generates a star with vertex 0 in the middle
+ * @param vertices: number of vertices
+ * @param seed: seed of a random number generator
+ * @return list of n - 1 edges
+ */
+std::vector<weighted_edge> star_edges(int vertices, uint64_t seed)
+{
+	std::mt19937_64 rng(seed);
+	std::vector<weighted_edge> edges;
+	edges.reserve(vertices);
+
+	for (int x = 1; x < vertices; x++)
+		edges.push_back({ 0, x, random_weight(rng) });
+
+	return edges;
+}
+
+/**
+ * Generates a graph of a given kind with about 2^scale vertices
+ * @param kind: one of rmat, er, grid, path, star
+ * @param scale: logarithm of a number of vertices
+ * @param degree: average number of edges per vertex, used by rmat and er
+ * @param seed: seed of a random number generator
+ * @param edges: list of edges that will be generated
+ * @return true if a kind is known
+ */
+bool generate_edges(const std::string& kind, int scale, int degree, uint64_t seed,
+	std::vector<weighted_edge>& edges)
+{
+	int vertices = 1 << scale;
+
+	if (kind == "rmat") {
+		edges = rmat_edges(scale, degree, seed);
+	} else if (kind == "er") {
+		edges = erdos_renyi_edges(vertices, (size_t)vertices * degree, seed);
+	} else if (kind == "grid") {
+		// a square grid, or two squares side by side for odd scales
+		int rows = 1 << (scale / 2);
+		edges = grid_edges(rows, vertices / rows, seed);
+	} else if (kind == "path") {
+		edges = path_edges(vertices, seed);
+	} else if (kind == "star") {
+		edges = star_edges(vertices, seed);
+	} else {
+		std::cerr << "Error: unknown graph generator: " << kind << std::endl;
+		return false;
+	}
+
+	return true;
+}
@@ -4,8 +4,14 @@
  * @brief File contains implementation of a graph data structure
  */
 #include "../include/graph.h"
+#include "../include/mapped_file.h"
+#include "../include/edge_scanner.h"
+#include "../include/stats.h"
 
-#include <fstream>
+#include <algorithm>
+#include <new>
+#include <string>
+#include <utility>
 
 /**
  * Constucts a new edge
@@ -13,7 +19,8 @@
  * @param weight: weight of an edge
  * @param next: a pointer to a next edge in a linked list
  */
-edge::edge(int y, double weight, edge* next)
+template <typename Vertex, typename Weight>
+basic_edge<Vertex, Weight>::basic_edge(Vertex y, Weight weight, basic_edge* next)
 	:y(y), weight(weight), next(next)
 {
 }
@@ -24,16 +31,19 @@ edge::edge(int y, double weight, edge* next)
  * @param y: index of a vertex
  * @param weight: weight of an edge
  */
-void insert_front(edge*& head, int y, double weight)
+template <typename Vertex, typename Weight>
+void insert_front(basic_edge<Vertex, Weight>*& head, typename basic_edge<Vertex, Weight>::vertex_type y,
+	typename basic_edge<Vertex, Weight>::weight_type weight)
 {
-	head = new edge(y, weight, head);
+	head = new basic_edge<Vertex, Weight>(y, weight, head);
 }
 
 /*
  * Print a linked list.
  * @param head: head of a linked list to be printed
  */
-void print_edges(edge* head)
+template <typename Vertex, typename Weight>
+void print_edges(basic_edge<Vertex, Weight>* head)
 {
 	for (; head != nullptr; head = head->next) {
 		std::cout << "(" << head->y << ", " << head->weight << ") -> ";
@@ -43,12 +53,13 @@ void print_edges(edge* head)
 }
 
 /*
- * Free a linked list.
+ * Free a linked list of edges allocated with new.
  * @param head: head of a linked list to be freed
  */
-void free_edges(edge* head)
+template <typename Vertex, typename Weight>
+void free_edges(basic_edge<Vertex, Weight>* head)
 {
-	edge* tmp;
+	basic_edge<Vertex, Weight>* tmp;
 	while (head != nullptr) {
 		tmp = head;
 		head = head->next;
@@ -56,11 +67,128 @@ void free_edges(edge* head)
 	}
 }
 
+static const size_t min_slab_size = 1024; //!< number of nodes in the first slab of an arena
+static const size_t max_slab_size = 1 << 20; //!< upper bound on a number of nodes in a single slab
+
+/**
+ * Creates a new empty arena
+ */
+template <typename Vertex, typename Weight>
+basic_edge_arena<Vertex, Weight>::basic_edge_arena()
+	:cursor(nullptr), limit(nullptr), slab_size(min_slab_size)
+{
+}
+
+/**
+ * Takes over all slabs of another arena
+ * @param other: arena to be moved from
+ */
+template <typename Vertex, typename Weight>
+basic_edge_arena<Vertex, Weight>::basic_edge_arena(basic_edge_arena&& other) noexcept
+	:slabs(std::move(other.slabs)), cursor(other.cursor),
+	 limit(other.limit), slab_size(other.slab_size)
+{
+	other.slabs.clear();
+	other.cursor = nullptr;
+	other.limit = nullptr;
+	other.slab_size = min_slab_size;
+}
+
+/**
+ * Takes over all slabs of another arena, releasing the current ones
+ * @param other: arena to be moved from
+ */
+template <typename Vertex, typename Weight>
+basic_edge_arena<Vertex, Weight>& basic_edge_arena<Vertex, Weight>::operator=(basic_edge_arena&& other) noexcept
+{
+	if (this != &other) {
+		release_arena(*this);
+		std::swap(slabs, other.slabs);
+		std::swap(cursor, other.cursor);
+		std::swap(limit, other.limit);
+		std::swap(slab_size, other.slab_size);
+	}
+	return *this;
+}
+
+/**
+ * Releases all slabs of an arena
+ */
+template <typename Vertex, typename Weight>
+basic_edge_arena<Vertex, Weight>::~basic_edge_arena()
+{
+	release_arena(*this);
+}
+
+/**
+ * Allocates a contiguous block of uninitialized edge nodes from an arena
+ * @param arena: arena from which nodes are allocated
+ * @param n: number of nodes in a block
+ * @return pointer to the first node of a block
+ */
+template <typename Vertex, typename Weight>
+basic_edge<Vertex, Weight>* reserve_edges(basic_edge_arena<Vertex, Weight>& arena, size_t n)
+{
+	using edge_type = basic_edge<Vertex, Weight>;
+
+	if ((size_t)(arena.limit - arena.cursor) >= n) {
+		edge_type* block = arena.cursor;
+		arena.cursor += n;
+		return block;
+	}
+
+	// large blocks get a slab of their own, so the rest of the current slab is not wasted
+	if (n >= arena.slab_size) {
+		edge_type* block = static_cast<edge_type*>(::operator new(n * sizeof(edge_type)));
+		arena.slabs.push_back(block);
+		return block;
+	}
+
+	edge_type* slab = static_cast<edge_type*>(::operator new(arena.slab_size * sizeof(edge_type)));
+	arena.slabs.push_back(slab);
+	arena.cursor = slab + n;
+	arena.limit = slab + arena.slab_size;
+	arena.slab_size = std::min(arena.slab_size * 2, max_slab_size);
+
+	return slab;
+}
+
+/**
+ * Insert new edge allocated from an arena at the beggining of the list
+ * @param arena: arena that owns the new edge
+ * @param head: head of the linked list
+ * @param y: index of a vertex
+ * @param weight: weight of an edge
+ */
+template <typename Vertex, typename Weight>
+void insert_front(basic_edge_arena<Vertex, Weight>& arena, basic_edge<Vertex, Weight>*& head,
+	typename basic_edge<Vertex, Weight>::vertex_type y, typename basic_edge<Vertex, Weight>::weight_type weight)
+{
+	head = new (reserve_edges(arena, 1)) basic_edge<Vertex, Weight>(y, weight, head);
+}
+
+/**
+ * Releases all edges of an arena at once
+ * @param arena: arena to be released
+ */
+template <typename Vertex, typename Weight>
+void release_arena(basic_edge_arena<Vertex, Weight>& arena)
+{
+	for (basic_edge<Vertex, Weight>* slab : arena.slabs)
+		::operator delete(slab);
+
+	arena.slabs.clear();
+	arena.cursor = nullptr;
+	arena.limit = nullptr;
+	arena.slab_size = min_slab_size;
+}
+
 /**
  * Creates a new instance of a graph data structure
  */
-graph::graph()
-	:edges(8, nullptr), max_index(-1)
+template <typename Vertex, typename Weight>
+basic_graph<Vertex, Weight>::basic_graph()
+	:edges(8, nullptr), max_index(-1), num_edges(0)
 {
 }
 
@@ -70,24 +198,28 @@ graph::graph()
  * @param y: index of a second vertex
  * @param weight: weight of an edge
  */
-void add_edge(graph& g, int x, int y, double weight)
+template <typename Vertex, typename Weight>
+void add_edge(basic_graph<Vertex, Weight>& g, typename basic_graph<Vertex, Weight>::vertex_type x,
+	typename basic_graph<Vertex, Weight>::vertex_type y, typename basic_graph<Vertex, Weight>::weight_type weight)
 {
-	int max = std::max(x, y);
-	if (max >= (int)g.edges.size()) {
+	Vertex max = std::max(x, y);
+	if (max >= (Vertex)g.edges.size()) {
 		g.edges.resize(max * 2, nullptr);
 	}
 
 	g.max_index = std::max(g.max_index, max);
+	g.num_edges++;
 
-	insert_front(g.edges[x], y, weight);
-	insert_front(g.edges[y], x, weight);
+	insert_front(g.arena, g.edges[x], y, weight);
+	insert_front(g.arena, g.edges[y], x, weight);
 }
 
 /*
  * Print a graph.
  * @param g: graph to be printed
  */
-void print_graph(graph& g)
+template <typename Vertex, typename Weight>
+void print_graph(basic_graph<Vertex, Weight>& g)
 {
 	for (size_t i = 0; i < g.edges.size(); i++) {
 		if (g.edges[i] == nullptr)
@@ -99,57 +231,107 @@ void print_graph(graph& g)
 }
 
 /*
- * Free a graph.
+ * Free a graph. Edges owned by graph's arena are released slab by slab,
+ * edges inserted with insert_front without an arena must be freed with free_edges.
  * @param g: graph to be freed
  */
-void free_graph(graph& g)
+template <typename Vertex, typename Weight>
+void free_graph(basic_graph<Vertex, Weight>& g)
+{
+	release_arena(g.arena);
+	std::vector<basic_edge<Vertex, Weight>*>(8, nullptr).swap(g.edges);
+	g.max_index = -1;
+	g.num_edges = 0;
+}
+
+/**
+ * Moves edges of each vertex next to each other in a single block of memory,
+ * keeping the order of every adjacency list.
+ * @param g: graph to be compacted
+ */
+template <typename Vertex, typename Weight>
+void compact_graph(basic_graph<Vertex, Weight>& g)
 {
+	using edge_type = basic_edge<Vertex, Weight>;
+
+	size_t m = 0;
 	for (size_t i = 0; i < g.edges.size(); i++) {
-		free_edges(g.edges[i]);
+		for (edge_type* p = g.edges[i]; p != nullptr; p = p->next)
+			m++;
 	}
+
+	basic_edge_arena<Vertex, Weight> arena;
+	edge_type* block = m > 0 ? reserve_edges(arena, m) : nullptr;
+
+	for (size_t i = 0; i < g.edges.size(); i++) {
+		edge_type* head = g.edges[i];
+		edge_type** tail = &g.edges[i];
+
+		for (edge_type* p = head; p != nullptr; p = p->next) {
+			*tail = new (block) edge_type(p->y, p->weight, nullptr);
+			tail = &(*tail)->next;
+			block++;
+		}
+	}
+
+	g.arena = std::move(arena);
 }
 
 /**
- * Initializes a graph with a data from an input file
+ * Initializes a graph with a data from an input file. Integer weights must be written as integers,
+ * floating point weights that overflow a weight type make a file malformed.
  * @param path: path to an input file
  * @param g: graph that will be constructed with a data from a file
  * @return true if a graph was read from an input file successfuly
  */
-bool graph_from_file(const std::string& path, graph& g)
+template <typename Vertex, typename Weight>
+bool graph_from_file(const std::string& path, basic_graph<Vertex, Weight>& g)
 {
-	std::ifstream ist(path);
+	GAL_STATS_BEGIN(stats);
+	GAL_STATS_PHASE(stats, "graph_from_file");
 
-	if (!ist) {
+	mapped_file file;
+
+	if (!map_file(path, file)) {
 		std::cerr << "Error: cannot open input file: " << path << std::endl;
 		return false;
 	}
 
-	int x;
-	int y;
-	double weight;
-	char ch1, ch2, ch3, ch4;
-
-	while (true) {
-		ist >> ch1 >> x >> ch2 >> y >> ch3 >> weight >> ch4;
+	const char* p = file.data;
+	const char* end = file.data + file.size;
 
-		if (ist) {
-			if (ch1 != '(' || ch2 != ',' || ch3 != ',' || ch4 != ')') {
-				std::cerr << "Error: error while reading input file: " << path << std::endl;
-				return false;
-			}
-			add_edge(g, x, y, weight);
-		}
-		if (ist.peek() == ',')
-			ist.get();
+	Vertex x;
+	Vertex y;
+	Weight weight;
+	scan_result res;
 
-		if (ist.eof())
-			break;
+	// an edge cut short by the end of a file is ignored, as with a stream
+	while ((res = scan_edge(p, end, x, y, weight)) == scan_result::ok)
+		add_edge(g, x, y, weight);
 
-		if (ist.fail()) {
-			std::cerr << "Error: error while reading input file: " << path << std::endl;
-			return false;
-		}
+	if (res == scan_result::fail) {
+		std::cerr << "Error: error while reading input file: " << path << std::endl;
+		return false;
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+//! instantiates the graph and its functions for a type of vertex indices and a type of weights
+#define GAL_INSTANTIATE_GRAPH(V, W) \
+	template struct basic_edge<V, W>; \
+	template struct basic_edge_arena<V, W>; \
+	template struct basic_graph<V, W>; \
+	template void insert_front<V, W>(basic_edge<V, W>*&, V, W); \
+	template void print_edges<V, W>(basic_edge<V, W>*); \
+	template void free_edges<V, W>(basic_edge<V, W>*); \
+	template basic_edge<V, W>* reserve_edges<V, W>(basic_edge_arena<V, W>&, size_t); \
+	template void insert_front<V, W>(basic_edge_arena<V, W>&, basic_edge<V, W>*&, V, W); \
+	template void release_arena<V, W>(basic_edge_arena<V, W>&); \
+	template void add_edge<V, W>(basic_graph<V, W>&, V, V, W); \
+	template void print_graph<V, W>(basic_graph<V, W>&); \
+	template void free_graph<V, W>(basic_graph<V, W>&); \
+	template void compact_graph<V, W>(basic_graph<V, W>&); \
+	template bool graph_from_file<V, W>(const std::string&, basic_graph<V, W>&);
+
+GAL_GRAPH_TYPES(GAL_INSTANTIATE_GRAPH)
@@ -0,0 +1,348 @@
+/**
+ * @file graph_loader.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of multi-threaded loaders of graphs from text input files
+ */
+#include "../include/graph_loader.h"
+#include "../include/edge_scanner.h"
+#include "../include/mapped_file.h"
+#include "../include/parallel.h"
+#include "../include/stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+
+static const size_t min_chunk_size = 1 << 20; //!< smallest number of bytes of a file parsed by a single task
+static const size_t chunks_per_thread = 4; //!< chunks per thread, so threads that finish early take more work
+static const size_t edge_grain = 1 << 14; //!< number of edges processed by a thread at once
+static const size_t vertex_grain = 1 << 12; //!< number of vertices processed by a thread at once
+
+//! edges parsed from a single chunk of an input file
+struct edge_chunk {
+	const char* begin; //!< first byte of a chunk
+	const char* end; //!< opening parenthesis of the first edge of the next chunk, or end of a file
+	std::vector<weighted_edge> edges; //!< edges that begin in a chunk, in the order of a file
+	scan_result result; //!< scan_result::fail if a chunk has a malformed edge
+};
+
+/**
+ * Splits a file into chunks that begin at an opening parenthesis. Every edge of a well-formed
+ * file begins with one and no other token contains it, so chunks begin exactly where
+ * a sequential scan would begin an edge.
+ * @param data: first byte of a file
+ * @param size: size of a file in bytes
+ * @param threads: number of threads that will parse chunks
+ * @param chunks: list of chunks that will be filled
+ */
+static void split_chunks(const char* data, size_t size, int threads, std::vector<edge_chunk>& chunks)
+{
+	size_t chunk_size = std::max(min_chunk_size, size / (threads * chunks_per_thread) + 1);
+	const char* end = data + size;
+	const char* begin = data;
+
+	while (begin != end) {
+		const char* next = end;
+
+		if ((size_t)(end - begin) > chunk_size) {
+			const void* paren = std::memchr(begin + chunk_size, '(', end - begin - chunk_size);
+			if (paren != nullptr)
+				next = static_cast<const char*>(paren);
+		}
+
+		chunks.push_back({ begin, next, {}, scan_result::ok });
+		begin = next;
+	}
+}
+
+/**
+ * Parses edges that begin in a chunk. Edges may continue past the end of a chunk,
+ * only the end of a file stops a scan inside of an edge.
+ * @param chunk: chunk to be parsed
+ * @param end: end of a file
+ */
+static void parse_chunk(edge_chunk& chunk, const char* end)
+{
+	const char* p = chunk.begin;
+	int x;
+	int y;
+	double weight;
+
+	// an edge cut short by the end of a file is ignored, as with a stream
+	while (true) {
+		while (p != chunk.end && is_space(*p))
+			p++;
+
+		if (p == chunk.end)
+			break;
+
+		scan_result res = scan_edge(p, end, x, y, weight);
+		if (res != scan_result::ok) {
+			chunk.result = res;
+			break;
+		}
+		chunk.edges.push_back({ x, y, weight });
+	}
+}
+
+/**
+ * Reads all edges of an input file on multiple threads. A file is split into chunks that begin
+ * at an opening parenthesis of an edge, and every chunk is parsed into a buffer of its own.
+ * Edges are returned in the order of a file, and a file is accepted or rejected exactly as
+ * by graph_from_file.
+ * @param path: path to an input file
+ * @param edges: list of edges that will be filled with edges of a file
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ * @return true if edges were read from an input file successfuly
+ */
+bool edges_from_file(const std::string& path, std::vector<weighted_edge>& edges, int num_threads)
+{
+	GAL_STATS_BEGIN(stats);
+	GAL_STATS_PHASE(stats, "edges_from_file");
+
+	mapped_file file;
+
+	if (!map_file(path, file)) {
+		std::cerr << "Error: cannot open input file: " << path << std::endl;
+		return false;
+	}
+
+	int threads = parallel_thread_count(num_threads);
+	const char* end = file.data + file.size;
+	std::vector<edge_chunk> chunks;
+
+	split_chunks(file.data, file.size, threads, chunks);
+
+	parallel_for(0, chunks.size(), 1, [&] (size_t begin, size_t last, int) {
+		for (size_t k = begin; k < last; k++)
+			parse_chunk(chunks[k], end);
+	}, threads);
+
+	std::vector<size_t> first(chunks.size() + 1, 0);
+	for (size_t k = 0; k < chunks.size(); k++) {
+		if (chunks[k].result == scan_result::fail) {
+			std::cerr << "Error: error while reading input file: " << path << std::endl;
+			return false;
+		}
+		first[k + 1] = first[k] + chunks[k].edges.size();
+	}
+
+	edges.resize(first.back());
+
+	parallel_for(0, chunks.size(), 1, [&] (size_t begin, size_t last, int) {
+		for (size_t k = begin; k < last; k++) {
+			std::copy(chunks[k].edges.begin(), chunks[k].edges.end(), edges.begin() + first[k]);
+			std::vector<weighted_edge>().swap(chunks[k].edges);
+		}
+	}, threads);
+
+	return true;
+}
+
+/**
+ * Takes the last free position of a row, counting down from its end
+ * @param cursor: position after the last free position of a row
+ * @param shared: true if other threads may take positions of the same row
+ * @return taken position
+ */
+static inline size_t take_position(std::atomic<size_t>& cursor, bool shared)
+{
+	// read-modify-write operations are much slower, so a single thread avoids them
+	if (shared)
+		return cursor.fetch_sub(1, std::memory_order_relaxed) - 1;
+
+	size_t position = cursor.load(std::memory_order_relaxed) - 1;
+	cursor.store(position, std::memory_order_relaxed);
+	return position;
+}
+
+/**
+ * Computes positions of rows of a graph and the edges stored in each row. Edges of a row
+ * are ordered by decreasing index in a list, which is the order in which add_edge leaves them.
+ * @param edges: list of undirected edges
+ * @param n: number of vertices
+ * @param offsets: edges of vertex x will be stored at [offsets[x], offsets[x + 1])
+ * @param rows: index in a list of an edge stored at every position
+ * @param threads: number of threads to use
+ */
+static void build_rows(const std::vector<weighted_edge>& edges, size_t n,
+	std::vector<size_t>& offsets, std::vector<size_t>& rows, int threads)
+{
+	bool shared = threads > 1;
+	std::unique_ptr<std::atomic<size_t>[]> cursor(new std::atomic<size_t>[n]);
+
+	parallel_for(0, n, vertex_grain, [&] (size_t begin, size_t end, int) {
+		for (size_t x = begin; x < end; x++)
+			cursor[x].store(0, std::memory_order_relaxed);
+	}, threads);
+
+	// degrees are counted down from zero, so a cursor holds minus the degree of a vertex
+	parallel_for(0, edges.size(), edge_grain, [&] (size_t begin, size_t end, int) {
+		for (size_t e = begin; e < end; e++) {
+			take_position(cursor[edges[e].x], shared);
+			take_position(cursor[edges[e].y], shared);
+		}
+	}, threads);
+
+	// blocks of vertices are summed in parallel, then shifted by sums of the blocks before them
+	size_t blocks = (n + vertex_grain - 1) / vertex_grain;
+	std::vector<size_t> block_sum(blocks + 1, 0);
+
+	parallel_for(0, blocks, 1, [&] (size_t begin, size_t end, int) {
+		for (size_t b = begin; b < end; b++) {
+			size_t sum = 0;
+			for (size_t x = b * vertex_grain; x < std::min(n, (b + 1) * vertex_grain); x++)
+				sum -= cursor[x].load(std::memory_order_relaxed);
+			block_sum[b + 1] = sum;
+		}
+	}, threads);
+
+	for (size_t b = 0; b < blocks; b++)
+		block_sum[b + 1] += block_sum[b];
+
+	offsets.resize(n + 1);
+	offsets[n] = block_sum[blocks];
+
+	parallel_for(0, blocks, 1, [&] (size_t begin, size_t end, int) {
+		for (size_t b = begin; b < end; b++) {
+			size_t sum = block_sum[b];
+			for (size_t x = b * vertex_grain; x < std::min(n, (b + 1) * vertex_grain); x++) {
+				offsets[x] = sum;
+				sum -= cursor[x].load(std::memory_order_relaxed);
+				cursor[x].store(sum, std::memory_order_relaxed);
+			}
+		}
+	}, threads);
+
+	rows.resize(offsets[n]);
+
+	parallel_for(0, edges.size(), edge_grain, [&] (size_t begin, size_t end, int) {
+		for (size_t e = begin; e < end; e++) {
+			rows[take_position(cursor[edges[e].x], shared)] = e;
+			rows[take_position(cursor[edges[e].y], shared)] = e;
+		}
+	}, threads);
+
+	// a single thread fills rows from their ends in order of a list, threads fill them in any order
+	if (shared) {
+		parallel_for(0, n, vertex_grain, [&] (size_t begin, size_t end, int) {
+			for (size_t x = begin; x < end; x++)
+				std::sort(rows.begin() + offsets[x], rows.begin() + offsets[x + 1], std::greater<size_t>());
+		}, threads);
+	}
+}
+
+/**
+ * Finds a maximal index of a vertex of a list of edges on multiple threads
+ * @param edges: list of undirected edges
+ * @param threads: number of threads to use
+ * @return maximal index of a vertex, -1 if a list is empty
+ */
+static int max_vertex(const std::vector<weighted_edge>& edges, int threads)
+{
+	std::vector<int> local(threads, -1);
+
+	parallel_for(0, edges.size(), edge_grain, [&] (size_t begin, size_t end, int thread) {
+		int max_index = local[thread];
+		for (size_t e = begin; e < end; e++)
+			max_index = std::max(max_index, std::max(edges[e].x, edges[e].y));
+		local[thread] = max_index;
+	}, threads);
+
+	return *std::max_element(local.begin(), local.end());
+}
+
+/**
+ * Builds an adjacency list graph from a list of undirected edges on multiple threads.
+ * Degrees are counted, prefix-summed into positions of rows and edges are scattered into
+ * a single block of nodes. The result is the same as inserting the edges with add_edge
+ * and calling compact_graph.
+ * @param edges: list of undirected edges
+ * @param g: graph that will be constructed, its previous edges are released
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ */
+void build_graph(const std::vector<weighted_edge>& edges, graph& g, int num_threads)
+{
+	int threads = parallel_thread_count(num_threads);
+	int max_index = max_vertex(edges, threads);
+	size_t n = max_index + 1;
+
+	std::vector<size_t> offsets;
+	std::vector<size_t> rows;
+	build_rows(edges, n, offsets, rows, threads);
+
+	free_graph(g);
+	g.max_index = max_index;
+	g.num_edges = edges.size();
+	g.edges.assign(std::max(n, g.edges.size()), nullptr);
+
+	edge* block = rows.empty() ? nullptr : reserve_edges(g.arena, rows.size());
+
+	parallel_for(0, n, vertex_grain, [&] (size_t begin, size_t end, int) {
+		for (size_t x = begin; x < end; x++) {
+			size_t first = offsets[x];
+			size_t last = offsets[x + 1];
+
+			for (size_t i = first; i < last; i++) {
+				const weighted_edge& e = edges[rows[i]];
+				int y = e.x == (int)x ? e.y : e.x;
+				new (block + i) edge(y, e.weight, i + 1 < last ? block + i + 1 : nullptr);
+			}
+			g.edges[x] = first < last ? block + first : nullptr;
+		}
+	}, threads);
+}
+
+/**
+ * Builds a compressed sparse row graph from a list of undirected edges on multiple threads.
+ * The result is the same as of csr_from_edges.
+ * @param edges: list of undirected edges
+ * @param c: compressed sparse row graph that will be constructed
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ */
+void build_csr(const std::vector<weighted_edge>& edges, csr_graph& c, int num_threads)
+{
+	int threads = parallel_thread_count(num_threads);
+	int max_index = max_vertex(edges, threads);
+	size_t n = max_index + 1;
+
+	std::vector<size_t> rows;
+	build_rows(edges, n, c.offset_storage, rows, threads);
+
+	c.max_index = max_index;
+	c.neighbor_storage.resize(rows.size());
+	c.weight_storage.resize(rows.size());
+
+	parallel_for(0, n, vertex_grain, [&] (size_t begin, size_t end, int) {
+		for (size_t x = begin; x < end; x++) {
+			for (size_t i = c.offset_storage[x]; i < c.offset_storage[x + 1]; i++) {
+				const weighted_edge& e = edges[rows[i]];
+				c.neighbor_storage[i] = e.x == (int)x ? e.y : e.x;
+				c.weight_storage[i] = e.weight;
+			}
+		}
+	}, threads);
+
+	attach_storage(c);
+}
+
+/**
+ * Initializes a graph with a data from an input file on multiple threads
+ * @param path: path to an input file
+ * @param g: graph that will be constructed with a data from a file, its previous edges are released
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ * @return true if a graph was read from an input file successfuly
+ */
+bool parallel_graph_from_file(const std::string& path, graph& g, int num_threads)
+{
+	std::vector<weighted_edge> edges;
+
+	if (edges_from_file(path, edges, num_threads) == false)
+		return false;
+
+	build_graph(edges, g, num_threads);
+	return true;
+}
@@ -0,0 +1,576 @@
+/**
+ * @file graph_server.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a server that keeps graphs in memory and answers queries over a Unix domain socket
+ */
+#include "../include/graph_server.h"
+#include "../include/graph_snapshot.h"
+#include "../include/parallel.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static const int listen_backlog = 128; //!< number of connections a kernel queues before they are accepted
+static const int send_timeout_ms = 5000; //!< time a client may take to read an answer before it is disconnected
+
+/**
+ * Takes over a loaded graph
+ * @param name: path that a graph was loaded from
+ * @param c: loaded graph
+ */
+served_graph::served_graph(const std::string& name, csr_graph&& c)
+	:name(name), graph(std::move(c)), pool(graph.max_index + 1)
+{
+}
+
+/**
+ * Creates a worker of a server with a given number of graphs
+ * @param num_graphs: number of graphs of a server
+ */
+server_worker::server_worker(size_t num_graphs)
+	:workspaces(num_graphs)
+{
+}
+
+/**
+ * Creates a server without graphs that is not listening
+ */
+graph_server::graph_server()
+	:listen_fd(-1), wake_fd{ -1, -1 }, stopping(false)
+{
+}
+
+/**
+ * Stops a server if it is still running
+ */
+graph_server::~graph_server()
+{
+	stop_server(*this);
+}
+
+/**
+ * Loads a graph from a text edge list or a binary snapshot and adds it to a server.
+ * Graphs are numbered in order they are added, and must be added before a server starts.
+ * @param s: server that is not running
+ * @param path: path to an input file
+ * @param num_threads: number of threads used to load a graph, 0 means all hardware threads
+ * @return true if a graph was loaded successfuly
+ */
+bool add_graph(graph_server& s, const std::string& path, int num_threads)
+{
+	csr_graph c;
+
+	if (!load_graph(path, c, num_threads))
+		return false;
+
+	s.graphs.emplace_back(new served_graph(path, std::move(c)));
+	return true;
+}
+
+/**
+ * Checks if an index of a query names a vertex of a graph
+ * @param c: graph
+ * @param x: index from a query
+ * @return true if x is in [0, max_index]
+ */
+static bool is_vertex(const csr_graph& c, int64_t x)
+{
+	return x >= 0 && x <= c.max_index;
+}
+
+/**
+ * Breadth-first search that stops as soon as a target vertex is discovered
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param target: vertex to be found
+ * @param ws: workspace, reset before the run
+ */
+static void bfs_until(const csr_graph& c, int start, int target, traversal_workspace& ws)
+{
+	reset_workspace(ws);
+	discover(ws, start, -1, 0);
+
+	for (size_t head = 0; head < ws.touched.size() && !is_discovered(ws, target); head++) {
+		int x = ws.touched[head];
+
+		for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++) {
+			int y = c.neighbors[i];
+
+			if (is_discovered(ws, y))
+				continue;
+
+			discover(ws, y, x, ws.depth[x] + 1);
+			if (y == target)
+				break;
+		}
+	}
+}
+
+/**
+ * Answers a query on a graph, keeping traversal state in a workspace.
+ * Latency queries need a server and are answered by it.
+ * @param c: graph
+ * @param ws: workspace of a graph
+ * @param request: query
+ * @param response: answer, item_count is set when it is sent
+ * @param items: items of an answer
+ */
+void answer_query(const csr_graph& c, traversal_workspace& ws, const query_request& request,
+	query_response& response, std::vector<int64_t>& items)
+{
+	response = query_response();
+	response.status = (uint32_t)query_status::ok;
+	items.clear();
+
+	query_op op = static_cast<query_op>(request.op);
+
+	if (request.op >= (uint32_t)query_op_count || op == query_op::latency) {
+		response.status = (uint32_t)query_status::bad_op;
+		return;
+	}
+
+	if (op == query_op::info) {
+		response.vertices = c.max_index + 1;
+		response.value = c.max_index >= 0 ? (double)edge_count(c) : 0.0;
+		return;
+	}
+
+	bool needs_target = op == query_op::reach || op == query_op::path;
+
+	if (!is_vertex(c, request.source) || (needs_target && !is_vertex(c, request.target))) {
+		response.status = (uint32_t)query_status::bad_vertex;
+		return;
+	}
+
+	int source = (int)request.source;
+	int target = (int)request.target;
+
+	switch (op) {
+	case query_op::bfs: {
+		bfs(c, source, ws);
+
+		// vertices are discovered level by level, so every level is a run of equal depths
+		for (int x : ws.touched) {
+			if ((size_t)ws.depth[x] == items.size())
+				items.push_back(0);
+			items.back()++;
+		}
+
+		response.vertices = ws.touched.size();
+		response.value = (double)items.size() - 1;
+		break;
+	}
+	case query_op::reach:
+		bfs_until(c, source, target, ws);
+		response.vertices = ws.touched.size();
+		response.value = is_discovered(ws, target) ? 1.0 : 0.0;
+		break;
+	case query_op::path:
+		bfs_until(c, source, target, ws);
+		response.vertices = ws.touched.size();
+
+		if (!is_discovered(ws, target)) {
+			response.value = -1.0;
+			break;
+		}
+
+		for (int x = target; x != -1; x = ws.parent[x])
+			items.push_back(x);
+		std::reverse(items.begin(), items.end());
+		response.value = (double)ws.depth[target];
+		break;
+	case query_op::mst: {
+		maximum_spanning_tree(c, source, ws);
+
+		double weight = 0;
+		for (int x : ws.touched) {
+			if (x != source)
+				weight += ws.distance[x];
+		}
+
+		response.vertices = ws.touched.size();
+		response.value = weight;
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+/**
+ * Answers a latency query with the histogram of a kind of queries
+ * @param s: server
+ * @param request: query, its source names the kind of queries
+ * @param response: answer
+ * @param items: counts of every bucket of a histogram followed by the largest latency
+ */
+static void answer_latency(const graph_server& s, const query_request& request,
+	query_response& response, std::vector<int64_t>& items)
+{
+	response = query_response();
+	items.clear();
+
+	if (request.source < 0 || request.source >= query_op_count) {
+		response.status = (uint32_t)query_status::bad_op;
+		return;
+	}
+
+	latency_histogram h;
+	server_latency(s, static_cast<query_op>(request.source), h);
+
+	uint64_t count = h.count.load(std::memory_order_relaxed);
+	response.status = (uint32_t)query_status::ok;
+	response.vertices = count;
+	response.value = count > 0 ? (double)h.total_ns.load(std::memory_order_relaxed) / count : 0.0;
+
+	for (const std::atomic<uint64_t>& b : h.buckets)
+		items.push_back((int64_t)b.load(std::memory_order_relaxed));
+	items.push_back((int64_t)h.max_ns.load(std::memory_order_relaxed));
+}
+
+/**
+ * Answers a single query of a connection
+ * @param s: server
+ * @param w: state of a worker serving a connection
+ * @param fd: connected socket
+ * @param request: query read from a connection
+ * @return false if a connection was closed or failed
+ */
+static bool serve_request(graph_server& s, server_worker& w, int fd, const query_request& request)
+{
+	query_response response;
+	auto begin = std::chrono::steady_clock::now();
+
+	if (request.op == (uint32_t)query_op::latency) {
+		answer_latency(s, request, response, w.items);
+	} else if (request.graph >= s.graphs.size()) {
+		response = query_response();
+		response.status = (uint32_t)query_status::bad_graph;
+		w.items.clear();
+	} else {
+		served_graph& g = *s.graphs[request.graph];
+		std::unique_ptr<traversal_workspace>& ws = w.workspaces[request.graph];
+
+		if (!ws)
+			ws = acquire_workspace(g.pool);
+
+		answer_query(g.graph, *ws, request, response, w.items);
+	}
+
+	if (!send_response(fd, response, w.items, w.buffer))
+		return false;
+
+	if (request.op < (uint32_t)query_op_count) {
+		auto end = std::chrono::steady_clock::now();
+		uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+		record_latency(w.latency[request.op], ns);
+	}
+	return true;
+}
+
+/**
+ * Wakes a poller waiting for connections
+ * @param s: server
+ */
+static void wake_poller(graph_server& s)
+{
+	// a full pipe already wakes the poller, so a failed write is not an error
+	char wake = 0;
+	while (write(s.wake_fd[1], &wake, 1) < 0 && errno == EINTR)
+		;
+}
+
+/**
+ * Answers requests that arrived on connections, handing every connection back to the poller,
+ * until a server stops
+ * @param s: server
+ * @param w: state of a worker
+ */
+static void run_worker(graph_server& s, server_worker& w)
+{
+	while (true) {
+		pending_request p;
+		{
+			std::unique_lock<std::mutex> guard(s.lock);
+			s.ready.wait(guard, [&] { return s.stopping.load() || !s.pending.empty(); });
+
+			if (s.stopping.load())
+				break;
+
+			p = s.pending.front();
+			s.pending.pop_front();
+			s.connections.push_back(p.fd);
+		}
+
+		bool open = serve_request(s, w, p.fd, p.request);
+
+		{
+			std::lock_guard<std::mutex> guard(s.lock);
+			s.connections.erase(std::find(s.connections.begin(), s.connections.end(), p.fd));
+			if (open)
+				s.returned.push_back(p.fd);
+		}
+
+		if (open)
+			wake_poller(s);
+		else
+			close(p.fd);
+	}
+
+	for (size_t i = 0; i < w.workspaces.size(); i++) {
+		if (w.workspaces[i])
+			release_workspace(s.graphs[i]->pool, std::move(w.workspaces[i]));
+	}
+}
+
+//! Connection waiting in the poller, with the part of its next request read so far
+struct polled_connection {
+	int fd; //!< connected socket
+	size_t received; //!< number of bytes of request read so far
+	query_request request; //!< request being read
+};
+
+/**
+ * Reads the rest of a request of a connection without blocking
+ * @param c: connection that can be read from
+ * @return -1 if a connection was closed or failed, 1 if a request is complete, 0 if more bytes are needed
+ */
+static int read_request(polled_connection& c)
+{
+	char* p = reinterpret_cast<char*>(&c.request);
+
+	while (c.received < sizeof(c.request)) {
+		ssize_t got = recv(c.fd, p + c.received, sizeof(c.request) - c.received, MSG_DONTWAIT);
+		if (got < 0 && errno == EINTR)
+			continue;
+		if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			return 0;
+		if (got <= 0)
+			return -1;
+
+		c.received += got;
+	}
+	return 1;
+}
+
+/**
+ * Accepts connections, waits on all connections that are not being served at once and reads
+ * their requests, queueing complete ones for workers, until a server stops
+ * @param s: server
+ */
+static void run_poller(graph_server& s)
+{
+	std::vector<polled_connection> idle;
+	std::vector<polled_connection> still_idle;
+	std::vector<pollfd> fds;
+
+	while (!s.stopping.load()) {
+		fds.clear();
+		fds.push_back({ s.listen_fd, POLLIN, 0 });
+		fds.push_back({ s.wake_fd[0], POLLIN, 0 });
+		for (const polled_connection& c : idle)
+			fds.push_back({ c.fd, POLLIN, 0 });
+
+		if (poll(fds.data(), fds.size(), -1) < 0) {
+			if (errno == EINTR)
+				continue;
+			std::cerr << "Error: cannot wait for connections: " << std::strerror(errno) << std::endl;
+			break;
+		}
+
+		if (fds[1].revents != 0) {
+			char buffer[256];
+			while (read(s.wake_fd[0], buffer, sizeof(buffer)) > 0)
+				;
+		}
+
+		still_idle.clear();
+		size_t ready = 0;
+		{
+			std::lock_guard<std::mutex> guard(s.lock);
+
+			for (size_t k = 0; k < idle.size(); k++) {
+				polled_connection& c = idle[k];
+				int state = fds[k + 2].revents != 0 ? read_request(c) : 0;
+
+				if (state < 0) {
+					close(c.fd);
+				} else if (state > 0) {
+					s.pending.push_back({ c.fd, c.request });
+					ready++;
+				} else {
+					still_idle.push_back(c);
+				}
+			}
+
+			for (int fd : s.returned)
+				still_idle.push_back({ fd, 0, query_request() });
+			s.returned.clear();
+		}
+		idle.swap(still_idle);
+
+		if (ready == 1)
+			s.ready.notify_one();
+		else if (ready > 1)
+			s.ready.notify_all();
+
+		if ((fds[0].revents & POLLIN) != 0) {
+			int fd = accept4(s.listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+			if (fd >= 0) {
+				// a worker writing an answer to a client that does not read it gives up eventually
+				timeval timeout;
+				timeout.tv_sec = send_timeout_ms / 1000;
+				timeout.tv_usec = (send_timeout_ms % 1000) * 1000;
+				setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+				idle.push_back({ fd, 0, query_request() });
+			}
+		}
+	}
+
+	for (const polled_connection& c : idle)
+		close(c.fd);
+}
+
+/**
+ * Starts listening on a Unix domain socket and answering queries on a pool of worker threads.
+ * A stale socket file left by a previous server is replaced.
+ * @param s: server with all its graphs added
+ * @param socket_path: path of a socket
+ * @param num_threads: number of worker threads, 0 means all hardware threads
+ * @return true if a server started
+ */
+bool start_server(graph_server& s, const std::string& socket_path, int num_threads)
+{
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+
+	if (socket_path.size() >= sizeof(address.sun_path)) {
+		std::cerr << "Error: socket path is too long: " << socket_path << std::endl;
+		return false;
+	}
+	std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+	// only a socket is replaced, so a mistyped path does not delete a regular file
+	struct stat st;
+	if (lstat(socket_path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode))
+		unlink(socket_path.c_str());
+
+	s.listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (s.listen_fd < 0) {
+		std::cerr << "Error: cannot create socket: " << std::strerror(errno) << std::endl;
+		return false;
+	}
+
+	if (bind(s.listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+		|| listen(s.listen_fd, listen_backlog) != 0) {
+		std::cerr << "Error: cannot listen on socket: " << socket_path << ": " << std::strerror(errno) << std::endl;
+		close(s.listen_fd);
+		s.listen_fd = -1;
+		return false;
+	}
+
+	if (pipe2(s.wake_fd, O_CLOEXEC | O_NONBLOCK) != 0) {
+		std::cerr << "Error: cannot create pipe: " << std::strerror(errno) << std::endl;
+		close(s.listen_fd);
+		s.listen_fd = -1;
+		unlink(socket_path.c_str());
+		return false;
+	}
+
+	s.socket_path = socket_path;
+	s.stopping.store(false);
+
+	int threads = parallel_thread_count(num_threads);
+	s.workers.clear();
+	for (int t = 0; t < threads; t++)
+		s.workers.emplace_back(new server_worker(s.graphs.size()));
+
+	s.threads.emplace_back(run_poller, std::ref(s));
+	for (int t = 0; t < threads; t++)
+		s.threads.emplace_back(run_worker, std::ref(s), std::ref(*s.workers[t]));
+
+	return true;
+}
+
+/**
+ * Stops accepting connections, closes connections being served and waits for all threads
+ * @param s: server
+ */
+void stop_server(graph_server& s)
+{
+	if (s.listen_fd < 0)
+		return;
+
+	{
+		std::lock_guard<std::mutex> guard(s.lock);
+		s.stopping.store(true);
+
+		// a worker blocked on a read of a connection sees it closed
+		for (int fd : s.connections)
+			shutdown(fd, SHUT_RDWR);
+	}
+	s.ready.notify_all();
+
+	wake_poller(s);
+
+	for (std::thread& t : s.threads)
+		t.join();
+	s.threads.clear();
+
+	for (const pending_request& p : s.pending)
+		close(p.fd);
+	s.pending.clear();
+	for (int fd : s.returned)
+		close(fd);
+	s.returned.clear();
+
+	close(s.listen_fd);
+	close(s.wake_fd[0]);
+	close(s.wake_fd[1]);
+	unlink(s.socket_path.c_str());
+
+	s.listen_fd = -1;
+	s.wake_fd[0] = -1;
+	s.wake_fd[1] = -1;
+}
+
+/**
+ * Collects latencies of queries of a kind from all workers of a server
+ * @param s: server
+ * @param op: kind of queries
+ * @param h: histogram that receives samples
+ */
+void server_latency(const graph_server& s, query_op op, latency_histogram& h)
+{
+	for (const std::unique_ptr<server_worker>& w : s.workers)
+		merge_latency(h, w->latency[static_cast<uint32_t>(op)]);
+}
+
+/**
+ * Prints latency histograms of every kind of queries that a server answered
+ * @param s: server
+ * @param os: output stream
+ */
+void print_server_latency(const graph_server& s, std::ostream& os)
+{
+	for (int op = 0; op < query_op_count; op++) {
+		latency_histogram h;
+		server_latency(s, static_cast<query_op>(op), h);
+
+		if (h.count.load(std::memory_order_relaxed) > 0)
+			print_latency(h, query_op_name(static_cast<query_op>(op)), os);
+	}
+}
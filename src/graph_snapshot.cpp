@@ -0,0 +1,297 @@
+/**
+ * @file graph_snapshot.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a binary graph snapshot format that can be memory-mapped directly
+ */
+#include "../include/graph_snapshot.h"
+#include "../include/graph_loader.h"
+
+#include <fstream>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+static const char snapshot_magic[8] = { 'G', 'A', 'L', 'C', 'S', 'R', '\r', '\n' }; //!< first bytes of every snapshot
+static const uint32_t snapshot_version = 1; //!< version of a layout written by save_graph_binary
+
+static_assert(sizeof(snapshot_header) == 40, "snapshot header must not contain padding");
+static_assert(sizeof(size_t) == sizeof(uint64_t), "offsets are mapped in place as 64-bit integers");
+static_assert(sizeof(int) == sizeof(int32_t), "neighbours are mapped in place as 32-bit integers");
+
+//! state of a checksum computed over a stream of bytes
+struct checksum_state {
+	uint64_t hash = 14695981039346656037ull; //!< hash of all complete words
+	uint64_t pending = 0; //!< bytes of an incomplete word
+	unsigned pending_bytes = 0; //!< number of bytes in pending
+};
+
+/**
+ * Mixes a single 64-bit word into a checksum
+ * @param s: checksum state
+ * @param word: word to be mixed in
+ */
+static inline void checksum_word(checksum_state& s, uint64_t word)
+{
+	s.hash = (s.hash ^ word) * 1099511628211ull;
+}
+
+/**
+ * Adds bytes to a checksum, a word at a time
+ * @param s: checksum state
+ * @param data: bytes to be added
+ * @param size: number of bytes
+ */
+static void checksum_update(checksum_state& s, const char* data, size_t size)
+{
+	while (size > 0 && s.pending_bytes != 0) {
+		s.pending |= (uint64_t)(unsigned char)*data << (8 * s.pending_bytes);
+		data++;
+		size--;
+		if (++s.pending_bytes == 8) {
+			checksum_word(s, s.pending);
+			s.pending = 0;
+			s.pending_bytes = 0;
+		}
+	}
+
+	for (; size >= 8; data += 8, size -= 8) {
+		uint64_t word;
+		std::memcpy(&word, data, 8);
+		checksum_word(s, word);
+	}
+
+	for (; size > 0; data++, size--)
+		s.pending |= (uint64_t)(unsigned char)*data << (8 * s.pending_bytes++);
+}
+
+/**
+ * Finishes a checksum
+ * @param s: checksum state
+ * @return checksum of all added bytes
+ */
+static uint64_t checksum_final(checksum_state& s)
+{
+	if (s.pending_bytes != 0)
+		checksum_word(s, s.pending);
+
+	return s.hash ^ (s.hash >> 32);
+}
+
+/**
+ * Calculates a number of padding bytes between neighbours and weights of a snapshot
+ * @param edge_count: number of stored half-edges
+ * @return number of zero bytes that align weights to 8 bytes
+ */
+static size_t neighbor_padding(uint64_t edge_count)
+{
+	return (edge_count * sizeof(int32_t)) % 8 == 0 ? 0 : 8 - (edge_count * sizeof(int32_t)) % 8;
+}
+
+/**
+ * Returns a position of the first neighbour in a snapshot file
+ * @param header: header of a snapshot
+ * @return offset in bytes from the beginning of a file
+ */
+uint64_t snapshot_neighbors_offset(const snapshot_header& header)
+{
+	return sizeof(snapshot_header) + (header.vertex_count + 1) * sizeof(uint64_t);
+}
+
+/**
+ * Returns a position of the first weight in a snapshot file
+ * @param header: header of a snapshot
+ * @return offset in bytes from the beginning of a file
+ */
+uint64_t snapshot_weights_offset(const snapshot_header& header)
+{
+	return snapshot_neighbors_offset(header) + header.edge_count * sizeof(int32_t) + neighbor_padding(header.edge_count);
+}
+
+/**
+ * Checks if a header describes a snapshot of a supported version whose arrays fill a file exactly
+ * @param header: header read from the beginning of a file
+ * @param file_size: size of a whole file in bytes
+ * @param path: path to a file, used in error messages
+ * @return true if a header is valid
+ */
+bool check_snapshot_header(const snapshot_header& header, uint64_t file_size, const std::string& path)
+{
+	if (std::memcmp(header.magic, snapshot_magic, sizeof(header.magic)) != 0
+		|| header.header_size != sizeof(header)) {
+		std::cerr << "Error: invalid graph snapshot: " << path << std::endl;
+		return false;
+	}
+
+	if (header.version != snapshot_version) {
+		std::cerr << "Error: unsupported graph snapshot version: " << path << std::endl;
+		return false;
+	}
+
+	uint64_t payload_size = file_size - sizeof(header);
+	uint64_t max_vertices = (uint64_t)std::numeric_limits<int>::max() + 1;
+
+	if (header.vertex_count > max_vertices
+		|| header.edge_count > payload_size / (sizeof(int32_t) + sizeof(double))
+		|| (header.vertex_count + 1) * sizeof(uint64_t) + header.edge_count * sizeof(int32_t)
+			+ neighbor_padding(header.edge_count) + header.edge_count * sizeof(double) != payload_size) {
+		std::cerr << "Error: invalid graph snapshot: " << path << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Checks if a file starts with the magic number of a binary graph snapshot
+ * @param path: path to a file
+ * @return true if a file is a binary graph snapshot
+ */
+bool is_graph_snapshot(const std::string& path)
+{
+	std::ifstream ist(path, std::ios::binary);
+	char magic[sizeof(snapshot_magic)];
+
+	if (!ist.read(magic, sizeof(magic)))
+		return false;
+
+	return std::memcmp(magic, snapshot_magic, sizeof(magic)) == 0;
+}
+
+/**
+ * Saves a compressed sparse row graph as a binary snapshot
+ * @param c: graph to be saved
+ * @param path: path to an output file
+ * @return true if a snapshot was written successfuly
+ */
+bool save_graph_binary(const csr_graph& c, const std::string& path)
+{
+	std::ofstream ost(path, std::ios::binary);
+	if (!ost) {
+		std::cerr << "Error: cannot open output file: " << path << std::endl;
+		return false;
+	}
+
+	snapshot_header header;
+	std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+	header.version = snapshot_version;
+	header.header_size = sizeof(snapshot_header);
+	header.vertex_count = c.max_index + 1;
+	header.edge_count = edge_count(c);
+
+	const char padding[8] = { 0 };
+	const char* offsets = reinterpret_cast<const char*>(c.offsets);
+	const char* neighbors = reinterpret_cast<const char*>(c.neighbors);
+	const char* weights = reinterpret_cast<const char*>(c.weights);
+	size_t offsets_size = (header.vertex_count + 1) * sizeof(uint64_t);
+	size_t neighbors_size = header.edge_count * sizeof(int32_t);
+	size_t padding_size = neighbor_padding(header.edge_count);
+	size_t weights_size = header.edge_count * sizeof(double);
+
+	checksum_state s;
+	checksum_update(s, offsets, offsets_size);
+	checksum_update(s, neighbors, neighbors_size);
+	checksum_update(s, padding, padding_size);
+	checksum_update(s, weights, weights_size);
+	header.checksum = checksum_final(s);
+
+	ost.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	ost.write(offsets, offsets_size);
+	ost.write(neighbors, neighbors_size);
+	ost.write(padding, padding_size);
+	ost.write(weights, weights_size);
+
+	if (!ost.flush()) {
+		std::cerr << "Error: error while writing output file: " << path << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Maps a binary snapshot into memory. The arrays of a graph point directly into the mapping,
+ * so a graph is ready to use without any deserialization.
+ * @param path: path to a snapshot
+ * @param c: graph that will be backed by a snapshot
+ * @param verify: if true, the checksum of a whole snapshot is verified, which reads every page
+ * @return true if a snapshot was loaded successfuly
+ */
+bool load_graph_binary(const std::string& path, csr_graph& c, bool verify)
+{
+	mapped_file file;
+
+	if (!map_file(path, file)) {
+		std::cerr << "Error: cannot open input file: " << path << std::endl;
+		return false;
+	}
+
+	snapshot_header header;
+	if (file.size < sizeof(header)) {
+		std::cerr << "Error: invalid graph snapshot: " << path << std::endl;
+		return false;
+	}
+	std::memcpy(&header, file.data, sizeof(header));
+
+	if (!check_snapshot_header(header, file.size, path))
+		return false;
+
+	uint64_t payload_size = file.size - sizeof(header);
+
+	const char* payload = file.data + sizeof(header);
+
+	if (verify) {
+		checksum_state s;
+		checksum_update(s, payload, payload_size);
+		if (checksum_final(s) != header.checksum) {
+			std::cerr << "Error: checksum mismatch in graph snapshot: " << path << std::endl;
+			return false;
+		}
+	}
+
+	const size_t* offsets = reinterpret_cast<const size_t*>(payload);
+	if (offsets[0] != 0 || offsets[header.vertex_count] != header.edge_count) {
+		std::cerr << "Error: invalid graph snapshot: " << path << std::endl;
+		return false;
+	}
+
+	const char* neighbors = file.data + snapshot_neighbors_offset(header);
+	const char* weights = file.data + snapshot_weights_offset(header);
+
+	c.offset_storage.clear();
+	c.neighbor_storage.clear();
+	c.weight_storage.clear();
+
+	// the mapping does not move when it is handed over to a graph
+	c.snapshot = std::move(file);
+	c.offsets = offsets;
+	c.neighbors = reinterpret_cast<const int*>(neighbors);
+	c.weights = reinterpret_cast<const double*>(weights);
+	c.max_index = (int)(header.vertex_count - 1);
+
+	return true;
+}
+
+/**
+ * Loads a graph either from a binary snapshot or from a text edge list,
+ * choosing a loader by the magic number at the beginning of a file.
+ * Text edge lists are parsed and built on multiple threads.
+ * @param path: path to an input file
+ * @param c: graph that will be constructed with a data from a file
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ * @return true if a graph was read from an input file successfuly
+ */
+bool load_graph(const std::string& path, csr_graph& c, int num_threads)
+{
+	if (is_graph_snapshot(path))
+		return load_graph_binary(path, c);
+
+	// the edge list is built directly into rows, skipping the adjacency list
+	std::vector<weighted_edge> edges;
+
+	if (edges_from_file(path, edges, num_threads) == false)
+		return false;
+
+	build_csr(edges, c, num_threads);
+
+	return true;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file incremental_mst.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a maximum spanning forest maintained under edge insertions
+ */
+#include "../include/incremental_mst.h"
+
+#include <limits>
+
+/**
+ * Makes sure that data and nodes exist for all vertices of a graph
+ * @param m: maintained maximum spanning forest
+ */
+static void grow(incremental_mst& m)
+{
+	size_t n = m.g.max_index + 1;
+
+	if (m.data.intree.size() < n) {
+		m.data.intree.resize(n, false);
+		m.data.distance.resize(n, std::numeric_limits<double>::min());
+		m.data.parent.resize(n, -1);
+	}
+
+	while (m.vertex_node.size() < n) {
+		m.vertex_node.push_back(lct_add_node(m.tree, std::numeric_limits<double>::infinity()));
+		m.edge_x.push_back(-1);
+		m.edge_y.push_back(-1);
+	}
+}
+
+/**
+ * Connects two vertices with an edge node
+ * @param m: maintained maximum spanning forest
+ * @param x: index of a first vertex
+ * @param y: index of a second vertex
+ * @param weight: weight of an edge
+ * @param e: edge node to be reused, -1 to create a new one
+ */
+static void link_edge(incremental_mst& m, int x, int y, double weight, int e)
+{
+	if (e == -1) {
+		e = lct_add_node(m.tree, weight);
+		m.edge_x.push_back(-1);
+		m.edge_y.push_back(-1);
+	} else {
+		lct_set_value(m.tree, e, weight);
+	}
+
+	m.edge_x[e] = x;
+	m.edge_y[e] = y;
+	lct_link(m.tree, m.vertex_node[x], e);
+	lct_link(m.tree, e, m.vertex_node[y]);
+}
+
+/**
+ * Starts maintaining a maximum spanning forest
+ * @param g: graph that edges will be added to
+ * @param data: maximum spanning forest of g, brought up to date by materialize_forest
+ */
+incremental_mst::incremental_mst(graph& g, mst_data& data)
+	:g(g), data(data)
+{
+	grow(*this);
+
+	for (size_t x = 0; x < data.parent.size(); x++) {
+		if (data.parent[x] != -1)
+			link_edge(*this, (int)x, data.parent[x], data.distance[x], -1);
+	}
+}
+
+/**
+ * Adds an edge to a graph and updates its maximum spanning forest. If both vertices are
+ * already connected, the lightest edge on the forest path between them is replaced when the new
+ * edge is heavier. An insertion takes amortized O(log n) time, data is not changed by it.
+ * @param m: maintained maximum spanning forest
+ * @param x: index of a first vertex
+ * @param y: index of a second vertex
+ * @param weight: weight of an edge
+ * @return true if the edge became part of the forest
+ */
+bool insert_edge(incremental_mst& m, int x, int y, double weight)
+{
+	add_edge(m.g, x, y, weight);
+	grow(m);
+
+	if (x == y)
+		return false;
+
+	int vx = m.vertex_node[x];
+	int vy = m.vertex_node[y];
+	int reused = -1;
+
+	if (lct_connected(m.tree, vx, vy)) {
+		int e = lct_path_min(m.tree, vx, vy);
+		if (m.tree.value[e] >= weight)
+			return false;
+
+		lct_cut(m.tree, m.vertex_node[m.edge_x[e]], e);
+		lct_cut(m.tree, e, m.vertex_node[m.edge_y[e]]);
+		reused = e;
+	}
+
+	link_edge(m, x, y, weight, reused);
+	return true;
+}
+
+/**
+ * Adds a batch of edges to a graph and updates its maximum spanning forest
+ * @param m: maintained maximum spanning forest
+ * @param edges: edges to be added, in order
+ * @return number of edges that became part of the forest
+ */
+size_t insert_edges(incremental_mst& m, const std::vector<weighted_edge>& edges)
+{
+	size_t added = 0;
+
+	for (const weighted_edge& e : edges) {
+		if (insert_edge(m, e.x, e.y, e.weight))
+			added++;
+	}
+
+	return added;
+}
+
+/**
+ * Writes the current forest into data in O(n) time. Every tree is rooted at its smallest vertex,
+ * like the forests of maximum_spanning_forest: roots have distance 0 and parent -1.
+ * @param m: maintained maximum spanning forest
+ */
+void materialize_forest(incremental_mst& m)
+{
+	size_t n = m.vertex_node.size();
+
+	// edge nodes of the forest are gathered into adjacency rows of their vertices
+	std::vector<size_t> offsets(n + 1, 0);
+	for (size_t e = 0; e < m.edge_x.size(); e++) {
+		if (m.edge_x[e] != -1) {
+			offsets[m.edge_x[e] + 1]++;
+			offsets[m.edge_y[e] + 1]++;
+		}
+	}
+	for (size_t x = 0; x < n; x++)
+		offsets[x + 1] += offsets[x];
+
+	std::vector<int> edges(offsets[n]);
+	std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+	for (size_t e = 0; e < m.edge_x.size(); e++) {
+		if (m.edge_x[e] != -1) {
+			edges[fill[m.edge_x[e]]++] = (int)e;
+			edges[fill[m.edge_y[e]]++] = (int)e;
+		}
+	}
+
+	std::vector<char> visited(n, false);
+	std::vector<int> queue;
+
+	for (size_t root = 0; root < n; root++) {
+		if (visited[root])
+			continue;
+
+		m.data.parent[root] = -1;
+		if (offsets[root] == offsets[root + 1])
+			continue;
+
+		visited[root] = true;
+		m.data.distance[root] = 0;
+		m.data.intree[root] = true;
+		queue.assign(1, (int)root);
+
+		for (size_t k = 0; k < queue.size(); k++) {
+			int x = queue[k];
+
+			for (size_t i = offsets[x]; i < offsets[x + 1]; i++) {
+				int e = edges[i];
+				int y = m.edge_x[e] == x ? m.edge_y[e] : m.edge_x[e];
+				if (visited[y])
+					continue;
+
+				visited[y] = true;
+				m.data.parent[y] = x;
+				m.data.distance[y] = m.tree.value[e];
+				m.data.intree[y] = true;
+				queue.push_back(y);
+			}
+		}
+	}
+}
@@ -0,0 +1,150 @@
+/**
+ * @file indexed_heap.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of an indexed d-ary max-heap of vertices
+ */
+#include "../include/indexed_heap.h"
+#include "../include/stats.h"
+
+#include <cstddef>
+
+static const size_t heap_arity = 4; //!< number of children of every heap node
+
+/**
+ * Checks if an entry should be closer to the top of a heap than another one
+ * @param a: first entry
+ * @param b: second entry
+ * @return true if a has a greater key, or an equal key and a smaller vertex index
+ */
+template <typename Vertex>
+static inline bool heap_before(const basic_heap_entry<Vertex>& a, const basic_heap_entry<Vertex>& b)
+{
+	return a.key > b.key || (a.key == b.key && a.vertex < b.vertex);
+}
+
+/**
+ * Moves an entry towards the top of a heap
+ * @param h: heap
+ * @param i: position of an entry
+ */
+template <typename Vertex>
+static void sift_up(basic_indexed_heap<Vertex>& h, size_t i)
+{
+	basic_heap_entry<Vertex> e = h.entries[i];
+
+	while (i > 0) {
+		size_t parent = (i - 1) / heap_arity;
+		if (!heap_before(e, h.entries[parent]))
+			break;
+
+		h.entries[i] = h.entries[parent];
+		h.position[h.entries[i].vertex] = i;
+		i = parent;
+	}
+
+	h.entries[i] = e;
+	h.position[e.vertex] = i;
+}
+
+/**
+ * Moves an entry towards the bottom of a heap
+ * @param h: heap
+ * @param i: position of an entry
+ */
+template <typename Vertex>
+static void sift_down(basic_indexed_heap<Vertex>& h, size_t i)
+{
+	basic_heap_entry<Vertex> e = h.entries[i];
+	size_t n = h.entries.size();
+
+	while (true) {
+		size_t first = i * heap_arity + 1;
+		if (first >= n)
+			break;
+
+		size_t best = first;
+		size_t last = first + heap_arity < n ? first + heap_arity : n;
+		for (size_t c = first + 1; c < last; c++) {
+			if (heap_before(h.entries[c], h.entries[best]))
+				best = c;
+		}
+
+		if (!heap_before(h.entries[best], e))
+			break;
+
+		h.entries[i] = h.entries[best];
+		h.position[h.entries[i].vertex] = i;
+		i = best;
+	}
+
+	h.entries[i] = e;
+	h.position[e.vertex] = i;
+}
+
+/**
+ * Creates an empty heap
+ * @param capacity: number of vertices, vertices have indices in [0, capacity)
+ */
+template <typename Vertex>
+basic_indexed_heap<Vertex>::basic_indexed_heap(Vertex capacity)
+	:position(capacity, -1)
+{
+}
+
+/**
+ * Inserts a vertex into a heap or increases its key if it is already there.
+ * A key that is not greater than the current one is ignored.
+ * @param h: heap
+ * @param vertex: index of a vertex
+ * @param key: new key of a vertex
+ */
+template <typename Vertex>
+void heap_push_or_increase(basic_indexed_heap<Vertex>& h, typename basic_indexed_heap<Vertex>::vertex_type vertex,
+	double key)
+{
+	Vertex pos = h.position[vertex];
+	GAL_STATS_BEGIN(stats);
+
+	if (pos == -1) {
+		h.entries.push_back({ key, vertex });
+		sift_up(h, h.entries.size() - 1);
+		GAL_STATS_ADD(stats, heap_pushes, 1);
+	} else if (key > h.entries[pos].key) {
+		h.entries[pos].key = key;
+		sift_up(h, pos);
+		GAL_STATS_ADD(stats, heap_increases, 1);
+	}
+}
+
+/**
+ * Removes a vertex with the greatest key from a heap
+ * @param h: non-empty heap
+ * @return index of the removed vertex
+ */
+template <typename Vertex>
+Vertex heap_pop(basic_indexed_heap<Vertex>& h)
+{
+	Vertex top = h.entries.front().vertex;
+	h.position[top] = -1;
+
+	GAL_STATS_BEGIN(stats);
+	GAL_STATS_ADD(stats, heap_pops, 1);
+
+	basic_heap_entry<Vertex> last = h.entries.back();
+	h.entries.pop_back();
+
+	if (!h.entries.empty()) {
+		h.entries.front() = last;
+		sift_down(h, 0);
+	}
+
+	return top;
+}
+
+template struct basic_indexed_heap<int>;
+template void heap_push_or_increase<int>(basic_indexed_heap<int>&, int, double);
+template int heap_pop<int>(basic_indexed_heap<int>&);
+
+template struct basic_indexed_heap<int64_t>;
+template void heap_push_or_increase<int64_t>(basic_indexed_heap<int64_t>&, int64_t, double);
+template int64_t heap_pop<int64_t>(basic_indexed_heap<int64_t>&);
@@ -0,0 +1,159 @@
+/**
+ * @file latency_histogram.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a histogram of latencies with power of two buckets
+ */
+#include "../include/latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+/**
+ * Creates an empty histogram
+ */
+latency_histogram::latency_histogram()
+	:count(0), total_ns(0), max_ns(0)
+{
+	for (std::atomic<uint64_t>& b : buckets)
+		b.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * Copies counts of another histogram
+ * @param other: histogram to be copied
+ */
+latency_histogram::latency_histogram(const latency_histogram& other)
+	:latency_histogram()
+{
+	*this = other;
+}
+
+/**
+ * Copies counts of another histogram
+ * @param other: histogram to be copied
+ */
+latency_histogram& latency_histogram::operator=(const latency_histogram& other)
+{
+	for (int b = 0; b < latency_buckets; b++)
+		buckets[b].store(other.buckets[b].load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+	count.store(other.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	total_ns.store(other.total_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	max_ns.store(other.max_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	return *this;
+}
+
+/**
+ * Returns a bucket of a latency
+ * @param ns: latency in nanoseconds
+ * @return index of a bucket
+ */
+int latency_bucket(uint64_t ns)
+{
+	return ns == 0 ? 0 : 63 - __builtin_clzll(ns);
+}
+
+/**
+ * Increments a counter that only the calling thread writes, without a read-modify-write
+ * @param counter: counter
+ * @param n: increment
+ */
+static void add_relaxed(std::atomic<uint64_t>& counter, uint64_t n)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+/**
+ * Adds a sample to a histogram. Must not be called by two threads on the same histogram at once.
+ * @param h: histogram
+ * @param ns: latency in nanoseconds
+ */
+void record_latency(latency_histogram& h, uint64_t ns)
+{
+	add_relaxed(h.buckets[latency_bucket(ns)], 1);
+	add_relaxed(h.count, 1);
+	add_relaxed(h.total_ns, ns);
+
+	if (ns > h.max_ns.load(std::memory_order_relaxed))
+		h.max_ns.store(ns, std::memory_order_relaxed);
+}
+
+/**
+ * Adds all samples of one histogram to another
+ * @param into: histogram that receives samples
+ * @param from: histogram whose samples are added
+ */
+void merge_latency(latency_histogram& into, const latency_histogram& from)
+{
+	for (int b = 0; b < latency_buckets; b++)
+		add_relaxed(into.buckets[b], from.buckets[b].load(std::memory_order_relaxed));
+
+	add_relaxed(into.count, from.count.load(std::memory_order_relaxed));
+	add_relaxed(into.total_ns, from.total_ns.load(std::memory_order_relaxed));
+
+	uint64_t max = from.max_ns.load(std::memory_order_relaxed);
+	if (max > into.max_ns.load(std::memory_order_relaxed))
+		into.max_ns.store(max, std::memory_order_relaxed);
+}
+
+/**
+ * Estimates a percentile of latencies as the upper bound of a bucket that holds it
+ * @param h: histogram
+ * @param p: percentile in [0, 100]
+ * @return latency in nanoseconds, at most the largest sample, 0 if a histogram is empty
+ */
+uint64_t latency_percentile(const latency_histogram& h, double p)
+{
+	uint64_t total = 0;
+	for (const std::atomic<uint64_t>& b : h.buckets)
+		total += b.load(std::memory_order_relaxed);
+
+	if (total == 0)
+		return 0;
+
+	// rank of the sample that the percentile falls on, counted from 1
+	uint64_t rank = std::max<uint64_t>(1, (uint64_t)(p / 100.0 * total + 0.5));
+	uint64_t max = h.max_ns.load(std::memory_order_relaxed);
+	uint64_t seen = 0;
+
+	for (int b = 0; b < latency_buckets; b++) {
+		seen += h.buckets[b].load(std::memory_order_relaxed);
+		if (seen >= rank) {
+			uint64_t upper = b == latency_buckets - 1 ? UINT64_MAX : (uint64_t(2) << b) - 1;
+			return std::min(upper, max);
+		}
+	}
+
+	return max;
+}
+
+/**
+ * Prints a summary of a histogram and its non-empty buckets
+ * @param h: histogram
+ * @param name: name printed in front of a summary
+ * @param os: output stream
+ */
+void print_latency(const latency_histogram& h, const std::string& name, std::ostream& os)
+{
+	uint64_t count = h.count.load(std::memory_order_relaxed);
+	double mean_us = count > 0 ? h.total_ns.load(std::memory_order_relaxed) / 1000.0 / count : 0.0;
+
+	os << name << ": count " << count << std::fixed << std::setprecision(1)
+		<< ", mean " << mean_us << " us"
+		<< ", p50 " << latency_percentile(h, 50) / 1000.0 << " us"
+		<< ", p90 " << latency_percentile(h, 90) / 1000.0 << " us"
+		<< ", p99 " << latency_percentile(h, 99) / 1000.0 << " us"
+		<< ", max " << h.max_ns.load(std::memory_order_relaxed) / 1000.0 << " us" << std::endl;
+
+	for (int b = 0; b < latency_buckets; b++) {
+		uint64_t n = h.buckets[b].load(std::memory_order_relaxed);
+		if (n == 0)
+			continue;
+
+		uint64_t lower = b == 0 ? 0 : uint64_t(1) << b;
+		os << "  [" << lower / 1000.0 << " us, " << std::ldexp(1.0, b + 1) / 1000.0 << " us): " << n << std::endl;
+	}
+
+	os << std::defaultfloat << std::setprecision(6);
+}
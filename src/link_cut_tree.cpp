@@ -0,0 +1,258 @@
+/**
+ * @file link_cut_tree.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a link-cut tree with path minimum queries
+ */
+#include "../include/link_cut_tree.h"
+
+#include <cstddef>
+#include <utility>
+
+/**
+ * Adds a new single-node tree
+ * @param t: link-cut tree
+ * @param value: value of a node
+ * @return index of a new node
+ */
+int lct_add_node(link_cut_tree& t, double value)
+{
+	int x = (int)t.value.size();
+
+	t.left.push_back(-1);
+	t.right.push_back(-1);
+	t.up.push_back(-1);
+	t.flip.push_back(0);
+	t.value.push_back(value);
+	t.best.push_back(x);
+
+	return x;
+}
+
+/**
+ * Checks if a node is a root of its splay tree
+ * @param t: link-cut tree
+ * @param x: index of a node
+ * @return true if a parent of x is a path-parent or x has no parent
+ */
+static inline bool is_splay_root(const link_cut_tree& t, int x)
+{
+	int p = t.up[x];
+	return p == -1 || (t.left[p] != x && t.right[p] != x);
+}
+
+/**
+ * Applies a pending reversal of a node to its children
+ * @param t: link-cut tree
+ * @param x: index of a node
+ */
+static inline void push(link_cut_tree& t, int x)
+{
+	if (!t.flip[x])
+		return;
+
+	std::swap(t.left[x], t.right[x]);
+	if (t.left[x] != -1)
+		t.flip[t.left[x]] ^= 1;
+	if (t.right[x] != -1)
+		t.flip[t.right[x]] ^= 1;
+	t.flip[x] = 0;
+}
+
+/**
+ * Recomputes the node of the smallest value in a splay subtree of a node
+ * @param t: link-cut tree
+ * @param x: index of a node
+ */
+static inline void pull(link_cut_tree& t, int x)
+{
+	t.best[x] = x;
+
+	if (t.left[x] != -1 && t.value[t.best[t.left[x]]] < t.value[t.best[x]])
+		t.best[x] = t.best[t.left[x]];
+	if (t.right[x] != -1 && t.value[t.best[t.right[x]]] < t.value[t.best[x]])
+		t.best[x] = t.best[t.right[x]];
+}
+
+/**
+ * Rotates a node above its splay tree parent
+ * @param t: link-cut tree
+ * @param x: index of a node
+ */
+static void rotate(link_cut_tree& t, int x)
+{
+	int p = t.up[x];
+	int g = t.up[p];
+
+	if (!is_splay_root(t, p)) {
+		if (t.left[g] == p)
+			t.left[g] = x;
+		else
+			t.right[g] = x;
+	}
+	t.up[x] = g;
+
+	if (t.left[p] == x) {
+		t.left[p] = t.right[x];
+		if (t.right[x] != -1)
+			t.up[t.right[x]] = p;
+		t.right[x] = p;
+	} else {
+		t.right[p] = t.left[x];
+		if (t.left[x] != -1)
+			t.up[t.left[x]] = p;
+		t.left[x] = p;
+	}
+	t.up[p] = x;
+
+	pull(t, p);
+	pull(t, x);
+}
+
+/**
+ * Moves a node to the root of its splay tree
+ * @param t: link-cut tree
+ * @param x: index of a node
+ */
+static void splay(link_cut_tree& t, int x)
+{
+	// pending reversals are applied top-down before any rotation
+	t.path.clear();
+	for (int y = x; ; y = t.up[y]) {
+		t.path.push_back(y);
+		if (is_splay_root(t, y))
+			break;
+	}
+	for (size_t i = t.path.size(); i-- > 0; )
+		push(t, t.path[i]);
+
+	while (!is_splay_root(t, x)) {
+		int p = t.up[x];
+
+		if (!is_splay_root(t, p)) {
+			int g = t.up[p];
+			bool zig_zig = (t.left[g] == p) == (t.left[p] == x);
+			rotate(t, zig_zig ? p : x);
+		}
+		rotate(t, x);
+	}
+}
+
+/**
+ * Makes a path from the root of a tree to a node preferred, leaving the node at the root of its splay tree
+ * @param t: link-cut tree
+ * @param x: index of a node
+ */
+static void access(link_cut_tree& t, int x)
+{
+	int last = -1;
+
+	for (int y = x; y != -1; y = t.up[y]) {
+		splay(t, y);
+		t.right[y] = last;
+		pull(t, y);
+		last = y;
+	}
+	splay(t, x);
+}
+
+/**
+ * Makes a node the root of its tree
+ * @param t: link-cut tree
+ * @param x: index of a node
+ */
+static void make_root(link_cut_tree& t, int x)
+{
+	access(t, x);
+	t.flip[x] ^= 1;
+	push(t, x);
+}
+
+/**
+ * Finds the root of a tree that contains a node
+ * @param t: link-cut tree
+ * @param x: index of a node
+ * @return index of the root
+ */
+static int find_root(link_cut_tree& t, int x)
+{
+	access(t, x);
+
+	while (true) {
+		push(t, x);
+		if (t.left[x] == -1)
+			break;
+		x = t.left[x];
+	}
+	splay(t, x);
+
+	return x;
+}
+
+/**
+ * Changes a value of a node that is not linked to any other node
+ * @param t: link-cut tree
+ * @param x: index of a single-node tree
+ * @param value: new value of a node
+ */
+void lct_set_value(link_cut_tree& t, int x, double value)
+{
+	access(t, x);
+	t.value[x] = value;
+	pull(t, x);
+}
+
+/**
+ * Checks if two nodes are in the same tree
+ * @param t: link-cut tree
+ * @param x: index of a first node
+ * @param y: index of a second node
+ * @return true if there is a path between x and y
+ */
+bool lct_connected(link_cut_tree& t, int x, int y)
+{
+	return x == y || find_root(t, x) == find_root(t, y);
+}
+
+/**
+ * Connects two nodes of different trees with an edge
+ * @param t: link-cut tree
+ * @param x: index of a first node
+ * @param y: index of a second node
+ */
+void lct_link(link_cut_tree& t, int x, int y)
+{
+	make_root(t, x);
+	t.up[x] = y;
+}
+
+/**
+ * Removes an edge between two adjacent nodes
+ * @param t: link-cut tree
+ * @param x: index of a first node
+ * @param y: index of a second node
+ */
+void lct_cut(link_cut_tree& t, int x, int y)
+{
+	make_root(t, x);
+	access(t, y);
+
+	// the path x..y consists of x and y only, so x is the whole left subtree of y
+	push(t, y);
+	t.up[t.left[y]] = -1;
+	t.left[y] = -1;
+	pull(t, y);
+}
+
+/**
+ * Finds a node of the smallest value on a path between two nodes of the same tree
+ * @param t: link-cut tree
+ * @param x: index of a first node
+ * @param y: index of a second node
+ * @return index of a node of the smallest value
+ */
+int lct_path_min(link_cut_tree& t, int x, int y)
+{
+	make_root(t, x);
+	access(t, y);
+	return t.best[y];
+}
@@ -0,0 +1,119 @@
+/**
+ * @file mapped_file.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a read-only memory-mapped file
+ */
+#include "../include/mapped_file.h"
+
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * Creates an empty view
+ */
+mapped_file::mapped_file()
+	:data(nullptr), size(0), mapped(false)
+{
+}
+
+/**
+ * Takes over a mapping or a buffer of another view
+ * @param other: view to be moved from
+ */
+mapped_file::mapped_file(mapped_file&& other) noexcept
+	:data(nullptr), size(0), mapped(false)
+{
+	*this = std::move(other);
+}
+
+/**
+ * Takes over a mapping or a buffer of another view, releasing the current one
+ * @param other: view to be moved from
+ */
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+{
+	if (this != &other) {
+		unmap_file(*this);
+
+		mapped = other.mapped;
+		size = other.size;
+		buffer = std::move(other.buffer);
+		data = mapped ? other.data : buffer.data();
+
+		other.data = nullptr;
+		other.size = 0;
+		other.mapped = false;
+		other.buffer.clear();
+	}
+	return *this;
+}
+
+/**
+ * Unmaps a file
+ */
+mapped_file::~mapped_file()
+{
+	unmap_file(*this);
+}
+
+/**
+ * Maps a whole file into memory for sequential reading.
+ * Files that cannot be mapped are read into a buffer instead.
+ * @param path: path to a file
+ * @param file: view that will be initialized
+ * @return true if a file was opened successfuly
+ */
+bool map_file(const std::string& path, mapped_file& file)
+{
+	unmap_file(file);
+
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+		void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr != MAP_FAILED) {
+			madvise(addr, st.st_size, MADV_SEQUENTIAL);
+			close(fd);
+
+			file.data = static_cast<const char*>(addr);
+			file.size = st.st_size;
+			file.mapped = true;
+			return true;
+		}
+	}
+
+	// a read error ends the data, the same way it ends a stream
+	char chunk[1 << 16];
+	ssize_t n;
+	while ((n = read(fd, chunk, sizeof(chunk))) > 0)
+		file.buffer.append(chunk, n);
+
+	close(fd);
+
+	file.data = file.buffer.data();
+	file.size = file.buffer.size();
+	file.mapped = false;
+	return true;
+}
+
+/**
+ * Releases a mapping or a buffer of a file
+ * @param file: view to be released
+ */
+void unmap_file(mapped_file& file)
+{
+	if (file.mapped)
+		munmap(const_cast<char*>(file.data), file.size);
+
+	std::string().swap(file.buffer);
+	file.data = nullptr;
+	file.size = 0;
+	file.mapped = false;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file multi_source_bfs.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a bit-parallel multi-source breadth-first search algorithm
+ */
+#include "../include/multi_source_bfs.h"
+
+#include <algorithm>
+
+/**
+ * Initialize context that collects a depth of every vertex from every source
+ * @param c: graph on which algorithm will run
+ * @param sources: starting vertices
+ */
+ms_bfs_data::ms_bfs_data(const csr_graph& c, const std::vector<int>& sources)
+	:sources(sources), vertices(c.max_index + 1),
+	 depth(sources.size() * (c.max_index + 1), -1)
+{
+}
+
+/**
+ * Initialize context that reports reached vertices to a callback and does not collect depths
+ * @param c: graph on which algorithm will run
+ * @param sources: starting vertices
+ * @param process_vertices: callback invoked when a vertex is reached from some sources of a batch
+ */
+ms_bfs_data::ms_bfs_data(const csr_graph& c, const std::vector<int>& sources,
+	batch_callback&& process_vertices)
+	:process_vertices(process_vertices), sources(sources), vertices(c.max_index + 1)
+{
+}
+
+/**
+ * Reports that a vertex was reached at some depth from a set of sources of a batch
+ * @param data: data needed to run an algorithm
+ * @param x: index of a vertex
+ * @param level: distance in edges from the sources
+ * @param first: index of the first source of a batch
+ * @param reached: mask of sources of a batch
+ */
+static void reach(ms_bfs_data& data, int x, int level, size_t first, uint64_t reached)
+{
+	if (data.process_vertices)
+		data.process_vertices(x, level, first, reached);
+
+	if (data.depth.empty())
+		return;
+
+	for (uint64_t bits = reached; bits; bits &= bits - 1)
+		data.depth[(first + __builtin_ctzll(bits)) * data.vertices + x] = level;
+}
+
+/**
+ * Multi-source breadth-first search. Sources are traversed in batches of ms_bfs_batch, and every
+ * vertex holds a mask of sources of a batch that have seen it and a mask of sources for which it
+ * is in a frontier, so each level reads the edges of a graph once for the whole batch instead of
+ * once per source. Depths are the same as those of bfs run from each source separately.
+ * @param c: graph to be traversed
+ * @param data: data needed to run an algorithm
+ */
+void multi_source_bfs(const csr_graph& c, ms_bfs_data& data)
+{
+	int n = c.max_index + 1;
+
+	std::vector<uint64_t> seen(n);
+	std::vector<uint64_t> frontier(n);
+	std::vector<uint64_t> next(n);
+
+	for (size_t first = 0; first < data.sources.size(); first += ms_bfs_batch) {
+		size_t count = std::min<size_t>(ms_bfs_batch, data.sources.size() - first);
+
+		std::fill(seen.begin(), seen.end(), 0);
+		std::fill(frontier.begin(), frontier.end(), 0);
+
+		for (size_t s = 0; s < count; s++) {
+			int x = data.sources[first + s];
+			seen[x] |= uint64_t(1) << s;
+			frontier[x] |= uint64_t(1) << s;
+		}
+
+		for (int x = 0; x < n; x++)
+			if (frontier[x])
+				reach(data, x, 0, first, frontier[x]);
+
+		bool active = true;
+
+		for (int level = 1; active; level++) {
+			std::fill(next.begin(), next.end(), 0);
+
+			// one pass over the edges pushes the frontiers of all sources of a batch
+			for (int x = 0; x < n; x++) {
+				uint64_t f = frontier[x];
+				if (!f)
+					continue;
+
+				for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++)
+					next[c.neighbors[i]] |= f;
+			}
+
+			active = false;
+
+			for (int y = 0; y < n; y++) {
+				uint64_t reached = next[y] & ~seen[y];
+				frontier[y] = reached;
+
+				if (reached) {
+					seen[y] |= reached;
+					reach(data, y, level, first, reached);
+					active = true;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,350 @@
+/**
+ * @file parallel.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of helpers that run loops of graph algorithms on multiple threads
+ */
+#include "../include/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+static const int64_t deque_capacity = 128; //!< slots of a range deque, ranges are halved before they are pushed, so at most 64 are queued
+static const size_t cache_line = 64; //!< size of a cache line, deques of different threads do not share one
+
+//! Chase-Lev work-stealing deque of ranges of a loop. The owner pushes and pops at the bottom,
+//! other threads steal from the top. It never grows: an owner only pushes the upper half of
+//! the range it is splitting, so queued ranges shrink geometrically and fit into a fixed array.
+struct alignas(cache_line) range_deque {
+	std::atomic<int64_t> top{0}; //!< index of the oldest range, advanced by thieves
+	std::atomic<int64_t> bottom{0}; //!< index past the newest range, moved only by an owner
+	std::atomic<size_t> begin[deque_capacity]; //!< beginnings of queued ranges
+	std::atomic<size_t> end[deque_capacity]; //!< ends of queued ranges
+};
+
+/**
+ * Pushes a range at the bottom of a deque, called only by its owner
+ * @param d: deque
+ * @param begin: beginning of a range
+ * @param end: end of a range
+ */
+static void push_range(range_deque& d, size_t begin, size_t end)
+{
+	int64_t b = d.bottom.load(std::memory_order_relaxed);
+
+	d.begin[b % deque_capacity].store(begin, std::memory_order_relaxed);
+	d.end[b % deque_capacity].store(end, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	d.bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+/**
+ * Pops the newest range from the bottom of a deque, called only by its owner
+ * @param d: deque
+ * @param begin: beginning of a popped range
+ * @param end: end of a popped range
+ * @return false if a deque was empty or its last range was stolen
+ */
+static bool pop_range(range_deque& d, size_t& begin, size_t& end)
+{
+	int64_t b = d.bottom.load(std::memory_order_relaxed) - 1;
+	d.bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t t = d.top.load(std::memory_order_relaxed);
+
+	if (t > b) {
+		d.bottom.store(b + 1, std::memory_order_relaxed);
+		return false;
+	}
+
+	begin = d.begin[b % deque_capacity].load(std::memory_order_relaxed);
+	end = d.end[b % deque_capacity].load(std::memory_order_relaxed);
+
+	if (t < b)
+		return true;
+
+	// the last range is raced for with thieves
+	bool won = d.top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	d.bottom.store(b + 1, std::memory_order_relaxed);
+	return won;
+}
+
+/**
+ * Steals the oldest, and so the largest, range from the top of a deque
+ * @param d: deque of another thread
+ * @param begin: beginning of a stolen range
+ * @param end: end of a stolen range
+ * @return false if a deque was empty or another thread took the range first
+ */
+static bool steal_range(range_deque& d, size_t& begin, size_t& end)
+{
+	int64_t t = d.top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t b = d.bottom.load(std::memory_order_acquire);
+
+	if (t >= b)
+		return false;
+
+	begin = d.begin[t % deque_capacity].load(std::memory_order_relaxed);
+	end = d.end[t % deque_capacity].load(std::memory_order_relaxed);
+
+	return d.top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+//! Single call of parallel_for shared by a calling thread and the pool threads that joined it.
+//! Every participant owns one deque and the index of its deque is the thread index passed to a body.
+struct loop_job {
+	/**
+	 * Creates a job over a range
+	 * @param first: beginning of a range
+	 * @param last: end of a range
+	 * @param grain: number of iterations in a single chunk
+	 * @param body: body of a loop
+	 * @param threads: maximal number of participants
+	 */
+	loop_job(size_t first, size_t last, size_t grain, const parallel_body& body, int threads)
+		:grain(grain), body(body), deques(threads),
+		 remaining(last - first), tickets(threads - 1), next_index(1), finished(0)
+	{
+	}
+
+	size_t grain; //!< number of iterations in a single chunk, ranges are split at multiples of it from first
+	const parallel_body& body; //!< body of a loop, owned by a calling thread
+	std::vector<range_deque> deques; //!< deque of every participant
+
+	std::atomic<size_t> remaining; //!< iterations not run yet, a loop is done at zero
+	std::atomic<int> tickets; //!< pool threads that may still join a loop
+	std::atomic<int> next_index; //!< thread index of the next pool thread that joins
+	std::atomic<int> finished; //!< pool threads that joined and left a loop
+};
+
+/**
+ * Runs a range of a loop, splitting off its upper halves into a deque of a participant
+ * until a single chunk is left, so idle participants can steal them
+ * @param job: loop
+ * @param index: thread index of a participant
+ * @param begin: beginning of a range
+ * @param end: end of a range
+ */
+static void run_range(loop_job& job, int index, size_t begin, size_t end)
+{
+	range_deque& own = job.deques[index];
+
+	while (end - begin > job.grain) {
+		size_t chunks = (end - begin + job.grain - 1) / job.grain;
+		size_t middle = begin + chunks / 2 * job.grain;
+		push_range(own, middle, end);
+		end = middle;
+	}
+
+	job.body(begin, end, index);
+	job.remaining.fetch_sub(end - begin, std::memory_order_acq_rel);
+}
+
+/**
+ * Takes part in a loop until all of its iterations ran: pops ranges of its own deque first,
+ * then steals from other participants, starting from the next one
+ * @param job: loop
+ * @param index: thread index of a participant
+ */
+static void participate(loop_job& job, int index)
+{
+	int count = (int)job.deques.size();
+	size_t begin, end;
+
+	while (job.remaining.load(std::memory_order_acquire) != 0) {
+		if (pop_range(job.deques[index], begin, end)) {
+			run_range(job, index, begin, end);
+			continue;
+		}
+
+		bool stolen = false;
+		for (int k = 1; k < count && !stolen; k++)
+			stolen = steal_range(job.deques[(index + k) % count], begin, end);
+
+		if (stolen)
+			run_range(job, index, begin, end);
+		else
+			std::this_thread::yield();
+	}
+}
+
+//! Threads that run loops of all calls of parallel_for. A call posts its loop with a number of
+//! tickets, idle pool threads take a ticket each and join it. A pool thread that runs a body and
+//! calls parallel_for again joins only idle threads to the inner loop, so nested loops never run
+//! more threads than the pool has.
+struct thread_pool {
+	/**
+	 * Stops and joins all pool threads
+	 */
+	~thread_pool();
+
+	std::mutex lock; //!< guards every member below
+	std::condition_variable wake; //!< notified when a loop is posted or the pool stops
+	std::deque<std::shared_ptr<loop_job>> posted; //!< loops that have tickets left
+	std::vector<std::thread> threads; //!< pool threads, the calling thread is not one of them
+	bool pin = false; //!< true if pool threads are pinned to cores
+	bool stopping = false; //!< true when the pool is being destroyed
+};
+
+static thread_pool pool; //!< pool shared by all parallel loops of a program
+
+/**
+ * Pins a thread to a single core, pool threads are spread over cores in order
+ * @param t: thread
+ * @param k: index of a pool thread
+ */
+static void pin_thread(std::thread& t, size_t k)
+{
+	unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+	cpu_set_t set;
+
+	CPU_ZERO(&set);
+	// core 0 is left for the thread that started a program and joins its loops
+	CPU_SET((k + 1) % cores, &set);
+	pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+}
+
+/**
+ * Main function of a pool thread, waits for posted loops and joins them
+ */
+static void pool_thread()
+{
+	std::unique_lock<std::mutex> guard(pool.lock);
+
+	while (true) {
+		pool.wake.wait(guard, [] { return pool.stopping || !pool.posted.empty(); });
+		if (pool.stopping)
+			return;
+
+		std::shared_ptr<loop_job> job = pool.posted.front();
+		int left = job->tickets.load(std::memory_order_relaxed);
+
+		// a calling thread withdraws tickets of a finished loop, so taking one may fail
+		while (left > 0 && !job->tickets.compare_exchange_weak(left, left - 1, std::memory_order_acq_rel))
+			;
+
+		if (left <= 1)
+			pool.posted.pop_front();
+		if (left <= 0)
+			continue;
+
+		guard.unlock();
+
+		participate(*job, job->next_index.fetch_add(1, std::memory_order_relaxed));
+		job->finished.fetch_add(1, std::memory_order_release);
+
+		guard.lock();
+	}
+}
+
+/**
+ * Stops and joins all pool threads
+ */
+thread_pool::~thread_pool()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+
+	for (std::thread& t : threads)
+		t.join();
+}
+
+/**
+ * Returns a number of threads that a parallel algorithm will use
+ * @param num_threads: number of threads requested by a caller, 0 means all hardware threads
+ * @return number of threads, at least one
+ */
+int parallel_thread_count(int num_threads)
+{
+	if (num_threads > 0)
+		return num_threads;
+
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * Pins pool threads to cores, or stops pinning new ones. Pinning keeps threads next to data
+ * they touched in previous loops, but should be left off on machines shared with other services.
+ * @param pin: true to pin pool threads
+ */
+void parallel_pin_threads(bool pin)
+{
+	std::lock_guard<std::mutex> guard(pool.lock);
+
+	pool.pin = pin;
+	if (!pin)
+		return;
+
+	for (size_t k = 0; k < pool.threads.size(); k++)
+		pin_thread(pool.threads[k], k);
+}
+
+/**
+ * Splits a range into chunks and runs a body on them on multiple threads of a shared pool.
+ * A calling thread starts with the whole range and keeps splitting off halves, threads that
+ * run out of work steal the largest ranges left, so uneven chunks are balanced. A body may call
+ * parallel_for again, the inner loop is joined only by idle pool threads.
+ * @param first: beginning of a range
+ * @param last: end of a range
+ * @param grain: number of iterations in a single chunk
+ * @param body: function invoked for every chunk with a thread index in [0, parallel_thread_count(num_threads))
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ */
+void parallel_for(size_t first, size_t last, size_t grain, const parallel_body& body, int num_threads)
+{
+	if (first >= last)
+		return;
+
+	grain = std::max<size_t>(grain, 1);
+
+	size_t chunks = (last - first + grain - 1) / grain;
+	int threads = (int)std::min<size_t>(parallel_thread_count(num_threads), chunks);
+
+	if (threads == 1) {
+		body(first, last, 0);
+		return;
+	}
+
+	std::shared_ptr<loop_job> job = std::make_shared<loop_job>(first, last, grain, body, threads);
+	push_range(job->deques[0], first, last);
+
+	{
+		std::lock_guard<std::mutex> guard(pool.lock);
+
+		// the pool grows to the largest number of threads any call asked for
+		while ((int)pool.threads.size() < threads - 1) {
+			pool.threads.emplace_back(pool_thread);
+			if (pool.pin)
+				pin_thread(pool.threads.back(), pool.threads.size() - 1);
+		}
+
+		pool.posted.push_back(job);
+	}
+	pool.wake.notify_all();
+
+	participate(*job, 0);
+
+	// tickets nobody took are withdrawn, pool threads that joined are waited for,
+	// since they may still be stealing from the deques
+	int joined = threads - 1 - job->tickets.exchange(0, std::memory_order_acq_rel);
+	while (job->finished.load(std::memory_order_acquire) != joined)
+		std::this_thread::yield();
+
+	std::lock_guard<std::mutex> guard(pool.lock);
+	auto posted = std::find(pool.posted.begin(), pool.posted.end(), job);
+	if (posted != pool.posted.end())
+		pool.posted.erase(posted);
+}
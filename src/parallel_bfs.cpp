@@ -0,0 +1,123 @@
+/**
+ * @file parallel_bfs.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a multi-threaded level-synchronous breadth-first search algorithm
+ */
+#include "../include/parallel_bfs.h"
+#include "../include/parallel.h"
+#include "../include/stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+static const size_t frontier_grain = 256; //!< number of frontier vertices expanded by a thread at once
+
+/**
+ * Claims a vertex by setting its bit in a shared bitmap
+ * @param bits: bitmap shared by all threads
+ * @param i: index of a vertex
+ * @return true if this call set the bit, false if it was already set
+ */
+static inline bool claim(std::atomic<uint64_t>* bits, int i)
+{
+	uint64_t mask = uint64_t(1) << (i & 63);
+
+	// a plain load filters out most already discovered vertices without a write
+	if (bits[i >> 6].load(std::memory_order_relaxed) & mask)
+		return false;
+
+	return (bits[i >> 6].fetch_or(mask, std::memory_order_relaxed) & mask) == 0;
+}
+
+/**
+ * Level-synchronous breadth-first search on multiple threads. Vertices of each level are split
+ * between threads, a thread claims an undiscovered neighbour by setting its bit in a shared
+ * discovered bitmap with an atomic operation, and collects claimed vertices in its own frontier.
+ * Frontiers of all threads are merged into the next level at the level boundary.
+ * Like bfs_direction_optimizing, the callbacks of data are not invoked. It fills discovered,
+ * processed, parent and depth. Depths are the same as those of bfs, parents form an equally valid
+ * breadth-first search tree that depends on the order in which threads claim vertices.
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param data: data needed to run an algorithm
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ */
+void parallel_bfs(const csr_graph& c, int start, bfs_data& data, int num_threads)
+{
+	int n = c.max_index + 1;
+	size_t words = (n + 63) / 64;
+	int threads = parallel_thread_count(num_threads);
+
+	std::unique_ptr<std::atomic<uint64_t>[]> discovered(new std::atomic<uint64_t>[words]);
+	for (size_t i = 0; i < words; i++)
+		discovered[i].store(0, std::memory_order_relaxed);
+
+	std::vector<std::vector<int>> local(threads);
+	std::vector<size_t> position(threads + 1);
+	std::vector<int> frontier;
+	std::vector<int> next;
+	int level = 0;
+
+	// only the calling thread reports statistics, worker threads do not see them
+	GAL_STATS_BEGIN(stats);
+	GAL_STATS_PHASE(stats, "parallel bfs");
+
+	claim(discovered.get(), start);
+	data.parent[start] = -1;
+	data.depth[start] = 0;
+	frontier.push_back(start);
+	GAL_STATS_ADD(stats, vertices_discovered, 1);
+	GAL_STATS_LEVEL(stats, 0, frontier, 1);
+
+	while (!frontier.empty()) {
+		GAL_STATS_PHASE(stats, "parallel bfs level");
+		level++;
+
+		parallel_for(0, frontier.size(), frontier_grain, [&] (size_t begin, size_t end, int thread) {
+			std::vector<int>& out = local[thread];
+
+			for (size_t k = begin; k < end; k++) {
+				int x = frontier[k];
+
+				for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++) {
+					int y = c.neighbors[i];
+
+					// only the thread that claimed y writes its parent and depth
+					if (claim(discovered.get(), y)) {
+						data.parent[y] = x;
+						data.depth[y] = level;
+						out.push_back(y);
+					}
+				}
+			}
+		}, threads);
+
+		position[0] = 0;
+		for (int t = 0; t < threads; t++)
+			position[t + 1] = position[t] + local[t].size();
+
+		next.resize(position[threads]);
+
+		parallel_for(0, threads, 1, [&] (size_t begin, size_t end, int) {
+			for (size_t t = begin; t < end; t++) {
+				std::copy(local[t].begin(), local[t].end(), next.begin() + position[t]);
+				local[t].clear();
+			}
+		}, threads);
+
+		frontier.swap(next);
+		GAL_STATS_ADD(stats, vertices_discovered, frontier.size());
+		if (!frontier.empty())
+			GAL_STATS_LEVEL(stats, level, frontier, frontier.size());
+	}
+
+	for (int x = 0; x < n; x++) {
+		if ((discovered[x >> 6].load(std::memory_order_relaxed) >> (x & 63)) & 1) {
+			data.discovered[x] = true;
+			data.processed[x] = true;
+		}
+	}
+}
@@ -0,0 +1,178 @@
+/**
+ * @file query_protocol.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of the request/response protocol of the graph query server
+ */
+#include "../include/query_protocol.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static const char* const op_names[query_op_count] = {
+	"info", "bfs", "reach", "path", "mst", "latency"
+}; //!< names of kinds of queries, in order of query_op
+
+/**
+ * Returns a name of a kind of a query
+ * @param op: kind of a query
+ * @return name used by command line tools, "unknown" if op is out of range
+ */
+const char* query_op_name(query_op op)
+{
+	uint32_t i = static_cast<uint32_t>(op);
+	return i < (uint32_t)query_op_count ? op_names[i] : "unknown";
+}
+
+/**
+ * Finds a kind of a query by its name
+ * @param name: name used by command line tools
+ * @param op: found kind of a query
+ * @return false if there is no query of that name
+ */
+bool parse_query_op(const std::string& name, query_op& op)
+{
+	for (int i = 0; i < query_op_count; i++) {
+		if (name == op_names[i]) {
+			op = static_cast<query_op>(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Reads exactly n bytes from a socket, retrying interrupted and partial reads
+ * @param fd: socket
+ * @param buffer: destination of n bytes
+ * @param n: number of bytes
+ * @return false if a socket was closed or failed before n bytes arrived
+ */
+bool receive_fully(int fd, void* buffer, size_t n)
+{
+	char* p = static_cast<char*>(buffer);
+
+	while (n > 0) {
+		ssize_t got = recv(fd, p, n, 0);
+		if (got < 0 && errno == EINTR)
+			continue;
+		if (got <= 0)
+			return false;
+
+		p += got;
+		n -= got;
+	}
+	return true;
+}
+
+/**
+ * Writes exactly n bytes to a socket, retrying interrupted and partial writes.
+ * A peer that went away is reported as a failure instead of raising SIGPIPE.
+ * @param fd: socket
+ * @param buffer: source of n bytes
+ * @param n: number of bytes
+ * @return false if a socket was closed or failed before n bytes were written
+ */
+bool send_fully(int fd, const void* buffer, size_t n)
+{
+	const char* p = static_cast<const char*>(buffer);
+
+	while (n > 0) {
+		ssize_t sent = send(fd, p, n, MSG_NOSIGNAL);
+		if (sent < 0 && errno == EINTR)
+			continue;
+		if (sent <= 0)
+			return false;
+
+		p += sent;
+		n -= sent;
+	}
+	return true;
+}
+
+/**
+ * Sends a response header together with its items in a single write
+ * @param fd: socket
+ * @param response: header, item_count is set from items
+ * @param items: items of a response
+ * @param buffer: scratch buffer reused between responses
+ * @return false if a socket failed
+ */
+bool send_response(int fd, query_response& response, const std::vector<int64_t>& items,
+	std::vector<char>& buffer)
+{
+	response.item_count = (uint32_t)items.size();
+
+	size_t item_bytes = items.size() * sizeof(int64_t);
+	buffer.resize(sizeof(query_response) + item_bytes);
+
+	std::memcpy(buffer.data(), &response, sizeof(query_response));
+	if (item_bytes > 0)
+		std::memcpy(buffer.data() + sizeof(query_response), items.data(), item_bytes);
+
+	return send_fully(fd, buffer.data(), buffer.size());
+}
+
+/**
+ * Receives a response header and its items
+ * @param fd: socket
+ * @param response: received header
+ * @param items: received items
+ * @return false if a socket failed or was closed
+ */
+bool receive_response(int fd, query_response& response, std::vector<int64_t>& items)
+{
+	if (!receive_fully(fd, &response, sizeof(response)))
+		return false;
+
+	items.resize(response.item_count);
+	return receive_fully(fd, items.data(), items.size() * sizeof(int64_t));
+}
+
+/**
+ * Connects to a query server listening on a Unix domain socket
+ * @param path: path of a socket
+ * @return connected socket, -1 if a server cannot be reached
+ */
+int connect_server(const std::string& path)
+{
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+
+	if (path.size() >= sizeof(address.sun_path)) {
+		std::cerr << "Error: socket path is too long: " << path << std::endl;
+		return -1;
+	}
+	std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd < 0) {
+		std::cerr << "Error: cannot create socket: " << std::strerror(errno) << std::endl;
+		return -1;
+	}
+
+	if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+		std::cerr << "Error: cannot connect to server: " << path << ": " << std::strerror(errno) << std::endl;
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+/**
+ * Sends a query to a server and waits for its answer
+ * @param fd: socket connected with connect_server
+ * @param request: query to be sent
+ * @param response: received header
+ * @param items: received items
+ * @return false if a connection failed
+ */
+bool run_query(int fd, const query_request& request, query_response& response, std::vector<int64_t>& items)
+{
+	return send_fully(fd, &request, sizeof(request)) && receive_response(fd, response, items);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file radix_heap.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a monotone radix min-heap of vertices
+ */
+#include "../include/radix_heap.h"
+
+#include <cstring>
+
+/**
+ * Converts a non-negative double into an integer of the same order
+ * @param key: non-negative double
+ * @return bit pattern of a key
+ */
+static inline uint64_t key_bits(double key)
+{
+	uint64_t bits;
+	std::memcpy(&bits, &key, sizeof(bits));
+	return bits;
+}
+
+/**
+ * Finds a bucket of a key
+ * @param last: key of the last popped entry
+ * @param key: key of an entry
+ * @return 0 if keys are equal, otherwise 1 + index of the highest bit in which they differ
+ */
+static inline int bucket_of(uint64_t last, uint64_t key)
+{
+	return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+}
+
+/**
+ * Creates an empty heap
+ */
+radix_heap::radix_heap()
+	:last(0), count(0)
+{
+}
+
+/**
+ * Inserts a vertex into a heap
+ * @param h: heap
+ * @param vertex: index of a vertex
+ * @param key: non-negative key, not smaller than the last popped key
+ */
+void radix_push(radix_heap& h, int vertex, double key)
+{
+	uint64_t bits = key_bits(key);
+	h.buckets[bucket_of(h.last, bits)].push_back({ bits, vertex });
+	h.count++;
+}
+
+/**
+ * Removes an entry with the smallest key from a heap
+ * @param h: non-empty heap
+ * @param key: key of the removed entry
+ * @return index of the removed vertex
+ */
+int radix_pop(radix_heap& h, double& key)
+{
+	if (h.buckets[0].empty()) {
+		int i = 1;
+		while (h.buckets[i].empty())
+			i++;
+
+		// the smallest key of the first non-empty bucket becomes last, and all entries of the
+		// bucket move to lower buckets since they agree with it on all higher bits
+		uint64_t smallest = h.buckets[i][0].key;
+		for (const radix_entry& e : h.buckets[i]) {
+			if (e.key < smallest)
+				smallest = e.key;
+		}
+
+		h.last = smallest;
+		for (const radix_entry& e : h.buckets[i])
+			h.buckets[bucket_of(h.last, e.key)].push_back(e);
+		h.buckets[i].clear();
+	}
+
+	radix_entry e = h.buckets[0].back();
+	h.buckets[0].pop_back();
+	h.count--;
+
+	std::memcpy(&key, &e.key, sizeof(key));
+	return e.vertex;
+}
@@ -0,0 +1,288 @@
+/**
+ * @file reorder.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of locality-improving vertex reorderings of a graph
+ */
+#include "../include/reorder.h"
+#include "../include/indexed_heap.h"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+
+/**
+ * Appends vertices of a component to an order in breadth-first search order
+ * @param c: graph to be ordered
+ * @param start: first vertex of a component
+ * @param visited: a vector that information if a given vertex is already ordered
+ * @param order: order of vertices to be extended
+ * @param by_degree: true if neighbours are visited in ascending degree, false for their stored order
+ */
+static void append_component(const csr_graph& c, int start, std::vector<bool>& visited,
+	std::vector<int>& order, bool by_degree)
+{
+	std::vector<int> neighbours;
+	size_t head = order.size();
+
+	visited[start] = true;
+	order.push_back(start);
+
+	// the order itself is the queue, vertices leave it in order of discovery
+	while (head < order.size()) {
+		int x = order[head++];
+
+		neighbours.assign(c.neighbors + c.offsets[x], c.neighbors + c.offsets[x + 1]);
+		if (by_degree) {
+			std::stable_sort(neighbours.begin(), neighbours.end(), [&] (int a, int b) {
+				return degree(c, a) < degree(c, b);
+			});
+		}
+
+		for (int y : neighbours) {
+			if (!visited[y]) {
+				visited[y] = true;
+				order.push_back(y);
+			}
+		}
+	}
+}
+
+/**
+ * Computes a permutation of vertices of a graph
+ * @param c: graph whose vertices will be ordered
+ * @param order: kind of an ordering
+ * @return original indices of vertices in their new order
+ */
+std::vector<int> compute_vertex_order(const csr_graph& c, vertex_order order)
+{
+	int n = c.max_index + 1;
+	std::vector<int> vertices(n);
+	std::iota(vertices.begin(), vertices.end(), 0);
+
+	if (order == vertex_order::degree) {
+		std::stable_sort(vertices.begin(), vertices.end(), [&] (int a, int b) {
+			return degree(c, a) > degree(c, b);
+		});
+		return vertices;
+	}
+
+	// Cuthill-McKee starts every component at its vertex of the smallest degree
+	if (order == vertex_order::rcm) {
+		std::stable_sort(vertices.begin(), vertices.end(), [&] (int a, int b) {
+			return degree(c, a) < degree(c, b);
+		});
+	}
+
+	std::vector<bool> visited(n, false);
+	std::vector<int> result;
+	result.reserve(n);
+
+	for (int x : vertices) {
+		if (!visited[x])
+			append_component(c, x, visited, result, order == vertex_order::rcm);
+	}
+
+	if (order == vertex_order::rcm)
+		std::reverse(result.begin(), result.end());
+
+	return result;
+}
+
+/**
+ * Relabels vertices of a graph
+ * @param c: graph to be relabeled
+ * @param order: kind of an ordering
+ * @param r: relabeled graph and a mapping of indices that will be constructed
+ */
+void reorder_graph(const csr_graph& c, vertex_order order, reordered_graph& r)
+{
+	int n = c.max_index + 1;
+
+	r.old_id = compute_vertex_order(c, order);
+	r.new_id.assign(n, -1);
+	for (int v = 0; v < n; v++)
+		r.new_id[r.old_id[v]] = v;
+
+	csr_graph& out = r.graph;
+	out.max_index = c.max_index;
+	out.offset_storage.assign(n + 1, 0);
+	out.neighbor_storage.resize(edge_count(c));
+	out.weight_storage.resize(edge_count(c));
+
+	size_t k = 0;
+	for (int v = 0; v < n; v++) {
+		int x = r.old_id[v];
+
+		for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++) {
+			out.neighbor_storage[k] = r.new_id[c.neighbors[i]];
+			out.weight_storage[k] = c.weights[i];
+			k++;
+		}
+		out.offset_storage[v + 1] = k;
+	}
+
+	attach_storage(out);
+}
+
+/**
+ * Relabels vertices of an adjacency list graph
+ * @param g: graph to be relabeled
+ * @param order: kind of an ordering
+ * @param r: relabeled graph and a mapping of indices that will be constructed
+ */
+void reorder_graph(graph& g, vertex_order order, reordered_graph& r)
+{
+	csr_graph c;
+	freeze_graph(g, c);
+	reorder_graph(c, order, r);
+}
+
+/**
+ * Translates an index of a vertex, keeping -1 for no vertex
+ * @param ids: mapping of indices
+ * @param x: index of a vertex or -1
+ * @return mapped index or -1
+ */
+static inline int map_index(const std::vector<int>& ids, int x)
+{
+	return x == -1 ? -1 : ids[x];
+}
+
+//! visitor that forwards hooks of a traversal of a relabeled graph to callbacks with original indices
+template <typename Data>
+struct original_id_visitor {
+	const reordered_graph& r; //!< relabeled graph
+	Data& data; //!< data with callbacks of a caller
+
+	void process_vertex_early(int v) { data.process_vertex_early(r.old_id[v]); }
+	void process_edge(int v, int w) { data.process_edge(r.old_id[v], r.old_id[w]); }
+	void process_vertex_late(int v) { data.process_vertex_late(r.old_id[v]); }
+};
+
+/**
+ * Copies the state of a traversal from original indices to new indices
+ * @param r: relabeled graph
+ * @param data: state with original indices
+ * @param inner: state with new indices
+ */
+template <typename Data>
+static void to_new_ids(const reordered_graph& r, const Data& data, Data& inner)
+{
+	for (size_t v = 0; v < r.old_id.size(); v++) {
+		int x = r.old_id[v];
+		inner.discovered[v] = data.discovered[x];
+		inner.processed[v] = data.processed[x];
+		inner.parent[v] = map_index(r.new_id, data.parent[x]);
+	}
+}
+
+/**
+ * Copies the state of a traversal from new indices back to original indices
+ * @param r: relabeled graph
+ * @param inner: state with new indices
+ * @param data: state with original indices
+ */
+template <typename Data>
+static void to_old_ids(const reordered_graph& r, const Data& inner, Data& data)
+{
+	for (size_t v = 0; v < r.old_id.size(); v++) {
+		int x = r.old_id[v];
+		data.discovered[x] = inner.discovered[v];
+		data.processed[x] = inner.processed[v];
+		data.parent[x] = map_index(r.old_id, inner.parent[v]);
+	}
+}
+
+/**
+ * Breadth-first search on a relabeled graph. The start vertex, callbacks and data use original
+ * indices, and since neighbours keep their order the result is the same as that of bfs on the
+ * original graph.
+ * @param r: relabeled graph
+ * @param start: starting vertex, original index
+ * @param data: data needed to run an algorithm, sized for the original graph
+ */
+void bfs(const reordered_graph& r, int start, bfs_data& data)
+{
+	bfs_data inner(r.graph);
+	to_new_ids(r, data, inner);
+	for (size_t v = 0; v < r.old_id.size(); v++)
+		inner.depth[v] = data.depth[r.old_id[v]];
+
+	bfs(r.graph, r.new_id[start], inner, original_id_visitor<bfs_data>{ r, data });
+
+	to_old_ids(r, inner, data);
+	for (size_t v = 0; v < r.old_id.size(); v++)
+		data.depth[r.old_id[v]] = inner.depth[v];
+}
+
+/**
+ * Depth-first search on a relabeled graph. The start vertex, callbacks and data use original
+ * indices, and since neighbours keep their order the result is the same as that of dfs on the
+ * original graph.
+ * @param r: relabeled graph
+ * @param start: starting vertex, original index
+ * @param data: data needed to run an algorithm, sized for the original graph
+ */
+void dfs(const reordered_graph& r, int start, dfs_data& data)
+{
+	dfs_data inner(r.graph);
+	to_new_ids(r, data, inner);
+
+	dfs(r.graph, r.new_id[start], inner, original_id_visitor<dfs_data>{ r, data });
+
+	to_old_ids(r, inner, data);
+}
+
+/**
+ * Calculate a maximum spanning tree of a relabeled graph using Prim's algorithm with a heap.
+ * Ties are broken and the search falls back to vertex 0 by original indices, so the tree is the
+ * same as that of maximum_spanning_tree on the original graph.
+ * @param r: relabeled graph
+ * @param start: starting vertex, original index
+ * @param data: data needed to run an algorithm, sized for the original graph
+ */
+void maximum_spanning_tree(const reordered_graph& r, int start, mst_data& data)
+{
+	const csr_graph& c = r.graph;
+	int n = c.max_index + 1;
+
+	std::vector<bool> intree(n);
+	std::vector<double> distance(n);
+	std::vector<int> parent(n);
+
+	for (int v = 0; v < n; v++) {
+		int x = r.old_id[v];
+		intree[v] = data.intree[x];
+		distance[v] = data.distance[x];
+		parent[v] = map_index(r.new_id, data.parent[x]);
+	}
+
+	// the heap holds original indices, so equal distances are popped in the original order
+	indexed_heap h(n);
+	int x = r.new_id[start];
+	distance[x] = 0;
+
+	while (intree[x] == false) {
+		intree[x] = true;
+
+		for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++) {
+			int y = c.neighbors[i];
+			double weight = c.weights[i];
+
+			if ((weight > distance[y]) && (intree[y] == false)) {
+				distance[y] = weight;
+				parent[y] = x;
+				heap_push_or_increase(h, r.old_id[y], weight);
+			}
+		}
+
+		x = r.new_id[heap_empty(h) ? 0 : heap_pop(h)];
+	}
+
+	for (int v = 0; v < n; v++) {
+		int y = r.old_id[v];
+		data.intree[y] = intree[v];
+		data.distance[y] = distance[v];
+		data.parent[y] = map_index(r.old_id, parent[v]);
+	}
+}
@@ -0,0 +1,178 @@
+/**
+ * @file result_writer.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of buffered writers of results of graph algorithms in text and binary formats
+ */
+#include "../include/result_writer.h"
+
+#include <cerrno>
+#include <iostream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+static const char result_magic[8] = { 'G', 'A', 'L', 'R', 'E', 'S', '\r', '\n' }; //!< first bytes of every binary result file
+static const uint32_t result_version = 1; //!< version of a record layout written by writers
+
+/**
+ * Creates a writer that is not open
+ */
+result_writer::result_writer()
+	:fd(-1), owns_fd(false), failed(false), used(0)
+{
+}
+
+/**
+ * Flushes and closes a writer that is still open
+ */
+result_writer::~result_writer()
+{
+	if (fd >= 0)
+		close_writer(*this);
+}
+
+/**
+ * Opens a writer that truncates or creates a file
+ * @param w: writer that is not open
+ * @param path: path of an output file, "-" writes to the standard output
+ * @return true if a file was opened successfuly
+ */
+bool open_writer(result_writer& w, const std::string& path)
+{
+	if (path == "-") {
+		// output buffered by the streams goes first
+		std::cout.flush();
+		w.fd = STDOUT_FILENO;
+		w.owns_fd = false;
+	} else {
+		w.fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		w.owns_fd = true;
+	}
+
+	if (w.fd < 0) {
+		std::cerr << "Error: cannot open output file: " << path << std::endl;
+		return false;
+	}
+
+	w.path = path;
+	w.failed = false;
+	w.buffer.assign(writer_buffer_size, 0);
+	w.used = 0;
+	return true;
+}
+
+/**
+ * Writes a block of bytes to a file of a writer, retrying partial writes
+ * @param w: open writer
+ * @param data: bytes to be written
+ * @param n: number of bytes
+ */
+static void write_fully(result_writer& w, const char* data, size_t n)
+{
+	while (n > 0 && !w.failed) {
+		ssize_t written = write(w.fd, data, n);
+
+		if (written < 0 && errno == EINTR)
+			continue;
+
+		if (written <= 0) {
+			std::cerr << "Error: error while writing output file: " << w.path << std::endl;
+			w.failed = true;
+			break;
+		}
+
+		data += written;
+		n -= written;
+	}
+}
+
+/**
+ * Writes buffered output to a file
+ * @param w: open writer
+ */
+void flush_writer(result_writer& w)
+{
+	if (w.fd >= 0)
+		write_fully(w, w.buffer.data(), w.used);
+	w.used = 0;
+}
+
+/**
+ * Flushes buffered output and closes a file
+ * @param w: open writer
+ * @return true if all output was written successfuly
+ */
+bool close_writer(result_writer& w)
+{
+	flush_writer(w);
+
+	if (w.owns_fd && close(w.fd) != 0 && !w.failed) {
+		std::cerr << "Error: error while writing output file: " << w.path << std::endl;
+		w.failed = true;
+	}
+
+	w.fd = -1;
+	w.owns_fd = false;
+	std::vector<char>().swap(w.buffer);
+	return !w.failed;
+}
+
+/**
+ * Parses a name of a result format
+ * @param name: "text" or "binary"
+ * @param format: parsed format
+ * @return false if a name is unknown
+ */
+bool parse_result_format(const std::string& name, result_format& format)
+{
+	if (name == "text") {
+		format = result_format::text;
+	} else if (name == "binary") {
+		format = result_format::binary;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Appends bytes that do not fit into the rest of a buffer, flushing it first.
+ * Blocks larger than a buffer are written directly.
+ * @param w: open writer
+ * @param data: bytes to be written
+ * @param n: number of bytes
+ */
+void write_bytes_slow(result_writer& w, const void* data, size_t n)
+{
+	if (w.fd < 0)
+		return;
+
+	flush_writer(w);
+
+	if (n >= w.buffer.size()) {
+		write_fully(w, static_cast<const char*>(data), n);
+		return;
+	}
+
+	std::memcpy(w.buffer.data(), data, n);
+	w.used = n;
+}
+
+/**
+ * Writes a header of a binary result file
+ * @param w: open writer
+ * @param kind: kind of records that follow
+ * @param vertex_bytes: size of a vertex index
+ * @param weight_bytes: size of a weight, 0 if records have no weights
+ */
+void write_result_header(result_writer& w, result_kind kind, uint32_t vertex_bytes, uint32_t weight_bytes)
+{
+	result_header header;
+	std::memcpy(header.magic, result_magic, sizeof(header.magic));
+	header.version = result_version;
+	header.kind = static_cast<uint32_t>(kind);
+	header.vertex_bytes = vertex_bytes;
+	header.weight_bytes = weight_bytes;
+
+	write_bytes(w, &header, sizeof(header));
+}
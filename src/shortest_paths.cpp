@@ -0,0 +1,379 @@
+/**
+ * @file shortest_paths.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of single-source shortest paths algorithms
+ */
+#include "../include/shortest_paths.h"
+#include "../include/radix_heap.h"
+#include "../include/parallel.h"
+#include "../include/result_writer.h"
+
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+static const size_t vertex_grain = 1024; //!< number of vertices processed by a thread at once
+static const size_t frontier_grain = 64; //!< number of bucket vertices relaxed by a thread at once
+
+/**
+ * Constucts shortest paths' data
+ * @param g: graph on which algorithm will run
+ */
+sssp_data::sssp_data(graph& g)
+	:distance(g.max_index + 1, std::numeric_limits<double>::infinity()),
+	 parent(g.max_index + 1, -1)
+{
+}
+
+/**
+ * Constucts shortest paths' data for a compressed sparse row graph
+ * @param c: graph on which algorithm will run
+ */
+sssp_data::sssp_data(const csr_graph& c)
+	:distance(c.max_index + 1, std::numeric_limits<double>::infinity()),
+	 parent(c.max_index + 1, -1)
+{
+}
+
+/**
+ * Checks that all edges of a graph have non-negative weights
+ * @param g: graph to be checked
+ * @return true if no weight is negative
+ */
+template <typename Graph>
+static bool has_non_negative_weights(const Graph& g)
+{
+	bool ok = true;
+
+	for (int x = 0; x <= g.max_index && ok; x++) {
+		for_each_edge(g, x, [&] (int, double weight) {
+			if (weight < 0)
+				ok = false;
+		});
+	}
+
+	if (!ok)
+		std::cerr << "Error: shortest paths need non-negative edge weights" << std::endl;
+
+	return ok;
+}
+
+/**
+ * Calculate shortest paths from a source vertex using Dijkstra's algorithm with a radix heap.
+ * A vertex may be in a heap many times, an entry is stale if its key is greater than
+ * the distance of its vertex.
+ * @param g: graph with non-negative edge weights
+ * @param source: starting vertex
+ * @param distance: a vector that holds a length of a shortest path to each vertex
+ * @param parent: a vector that holds an index of a previous vertex on a shortest path
+ */
+template <typename Graph>
+static void dijkstra_impl(const Graph& g, int source, std::vector<double>& distance,
+	std::vector<int>& parent)
+{
+	radix_heap h;
+
+	distance[source] = 0;
+	radix_push(h, source, 0);
+
+	while (!radix_empty(h)) {
+		double d;
+		int x = radix_pop(h, d);
+
+		if (d > distance[x])
+			continue;
+
+		for_each_edge(g, x, [&] (int y, double weight) {
+			double candidate = d + weight;
+
+			if (candidate < distance[y]) {
+				distance[y] = candidate;
+				parent[y] = x;
+				radix_push(h, y, candidate);
+			}
+		});
+	}
+}
+
+/**
+ * Calculate shortest paths from a source vertex using Dijkstra's algorithm with a radix heap
+ * @param g: graph with non-negative edge weights
+ * @param source: starting vertex
+ * @param data: data needed to run an algorithm
+ * @return false if a graph has an edge of negative weight
+ */
+bool dijkstra(graph& g, int source, sssp_data& data)
+{
+	if (!has_non_negative_weights(g))
+		return false;
+
+	dijkstra_impl(g, source, data.distance, data.parent);
+	return true;
+}
+
+/**
+ * Calculate shortest paths from a source vertex of a compressed sparse row graph using
+ * Dijkstra's algorithm with a radix heap
+ * @param c: graph with non-negative edge weights
+ * @param source: starting vertex
+ * @param data: data needed to run an algorithm
+ * @return false if a graph has an edge of negative weight
+ */
+bool dijkstra(const csr_graph& c, int source, sssp_data& data)
+{
+	if (!has_non_negative_weights(c))
+		return false;
+
+	dijkstra_impl(c, source, data.distance, data.parent);
+	return true;
+}
+
+/**
+ * Chooses a width of a bucket of delta-stepping. With weights spread evenly up to W and
+ * average degree d, a width of about W / d keeps buckets large enough to be processed in
+ * parallel while few vertices are relaxed more than once.
+ * @param c: graph
+ * @return width of a bucket
+ */
+static double choose_delta(const csr_graph& c)
+{
+	size_t m = edge_count(c);
+	if (m == 0)
+		return 1;
+
+	double total = 0;
+	for (size_t i = 0; i < m; i++)
+		total += c.weights[i];
+
+	double mean = total / m;
+	double avg_degree = (double)m / (c.max_index + 1);
+	double delta = 2 * mean / avg_degree;
+
+	return delta > 0 ? delta : 1;
+}
+
+/**
+ * Lowers a distance stored as an atomic bit pattern of a non-negative double
+ * @param distance: atomic distance of a vertex
+ * @param candidate: new distance
+ * @return true if this call lowered the distance
+ */
+static inline bool lower_distance(std::atomic<uint64_t>& distance, double candidate)
+{
+	uint64_t bits;
+	std::memcpy(&bits, &candidate, sizeof(bits));
+
+	// non-negative doubles compare like their bit patterns
+	uint64_t current = distance.load(std::memory_order_relaxed);
+	while (bits < current) {
+		if (distance.compare_exchange_weak(current, bits, std::memory_order_relaxed))
+			return true;
+	}
+	return false;
+}
+
+/**
+ * Reads a distance stored as an atomic bit pattern
+ * @param distance: atomic distance of a vertex
+ * @return distance as a double
+ */
+static inline double read_distance(const std::atomic<uint64_t>& distance)
+{
+	uint64_t bits = distance.load(std::memory_order_relaxed);
+	double d;
+	std::memcpy(&d, &bits, sizeof(d));
+	return d;
+}
+
+/**
+ * Returns a bucket of a distance. Placing vertices into buckets and recognizing stale ones
+ * both use it, so a distance rounded up across a bucket boundary is treated the same way by both.
+ * @param d: distance
+ * @param delta: width of a bucket
+ * @return index of a bucket
+ */
+static inline size_t bucket_of(double d, double delta)
+{
+	return (size_t)(d / delta);
+}
+
+/**
+ * Calculate shortest paths from a source vertex on multiple threads using delta-stepping.
+ * Vertices are settled in buckets of tentative distances of width delta, all vertices of the
+ * current bucket relax their edges in parallel and improve distances with atomic operations.
+ * Every thread collects improved vertices in its own buckets, which are merged per bucket.
+ * Distances are the same as those of dijkstra. Parents are chosen after distances are final,
+ * as the first neighbour on a shortest path in the order edges are stored.
+ * @param c: graph with non-negative edge weights
+ * @param source: starting vertex
+ * @param data: data needed to run an algorithm
+ * @param delta: width of a bucket, 0 chooses it from the average weight and degree of a graph
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ * @return false if a graph has an edge of negative weight
+ */
+bool delta_stepping(const csr_graph& c, int source, sssp_data& data, double delta, int num_threads)
+{
+	if (!has_non_negative_weights(c))
+		return false;
+
+	int n = c.max_index + 1;
+	int threads = parallel_thread_count(num_threads);
+
+	if (delta <= 0)
+		delta = choose_delta(c);
+
+	std::unique_ptr<std::atomic<uint64_t>[]> distance(new std::atomic<uint64_t>[n]);
+	double infinity = std::numeric_limits<double>::infinity();
+	uint64_t infinity_bits;
+	std::memcpy(&infinity_bits, &infinity, sizeof(infinity_bits));
+
+	parallel_for(0, n, vertex_grain, [&] (size_t begin, size_t end, int) {
+		for (size_t x = begin; x < end; x++)
+			distance[x].store(infinity_bits, std::memory_order_relaxed);
+	}, threads);
+
+	// buckets[t][b] holds vertices improved by thread t to a distance in [b * delta, (b + 1) * delta)
+	std::vector<std::vector<std::vector<int>>> buckets(threads);
+	std::vector<int> frontier;
+	size_t bucket = 0;
+
+	lower_distance(distance[source], 0);
+	frontier.push_back(source);
+
+	while (!frontier.empty()) {
+		parallel_for(0, frontier.size(), frontier_grain, [&] (size_t begin, size_t end, int thread) {
+			std::vector<std::vector<int>>& own = buckets[thread];
+
+			for (size_t k = begin; k < end; k++) {
+				int x = frontier[k];
+				double d = read_distance(distance[x]);
+
+				// a vertex improved into an earlier bucket was already relaxed from there
+				if (bucket_of(d, delta) < bucket)
+					continue;
+
+				for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++) {
+					int y = c.neighbors[i];
+					double candidate = d + c.weights[i];
+
+					if (lower_distance(distance[y], candidate)) {
+						size_t b = bucket_of(candidate, delta);
+						if (b < bucket)
+							b = bucket;
+						if (b >= own.size())
+							own.resize(b + 1);
+						own[b].push_back(y);
+					}
+				}
+			}
+		}, threads);
+
+		// vertices reached through light edges may land in the current bucket again
+		size_t next = std::numeric_limits<size_t>::max();
+		for (int t = 0; t < threads; t++) {
+			for (size_t b = bucket; b < buckets[t].size(); b++) {
+				if (!buckets[t][b].empty()) {
+					next = std::min(next, b);
+					break;
+				}
+			}
+		}
+
+		frontier.clear();
+		if (next == std::numeric_limits<size_t>::max())
+			break;
+
+		for (int t = 0; t < threads; t++) {
+			if (next < buckets[t].size()) {
+				frontier.insert(frontier.end(), buckets[t][next].begin(), buckets[t][next].end());
+				buckets[t][next].clear();
+			}
+		}
+		bucket = next;
+	}
+
+	std::atomic<size_t> orphans(0);
+
+	parallel_for(0, n, vertex_grain, [&] (size_t begin, size_t end, int) {
+		size_t local_orphans = 0;
+
+		for (size_t y = begin; y < end; y++) {
+			double d = read_distance(distance[y]);
+			data.distance[y] = d;
+
+			if ((int)y == source || d == infinity)
+				continue;
+
+			// every edge is stored in both directions, so neighbours are also predecessors;
+			// a strictly closer predecessor keeps parents free of cycles
+			for (size_t i = c.offsets[y]; i < c.offsets[y + 1]; i++) {
+				int x = c.neighbors[i];
+				double dx = read_distance(distance[x]);
+				if (dx < d && dx + c.weights[i] == d) {
+					data.parent[y] = x;
+					break;
+				}
+			}
+
+			if (data.parent[y] == -1)
+				local_orphans++;
+		}
+		orphans += local_orphans;
+	}, threads);
+
+	// vertices reached only through edges that do not increase a distance, like zero-weight ones,
+	// get parents by a search from vertices that already have one
+	if (orphans > 0) {
+		std::vector<int> queue;
+		for (int y = 0; y < n; y++) {
+			if (y == source || data.parent[y] != -1)
+				queue.push_back(y);
+		}
+
+		for (size_t head = 0; head < queue.size(); head++) {
+			int x = queue[head];
+
+			for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++) {
+				int y = c.neighbors[i];
+				if (y != source && data.parent[y] == -1 && data.distance[y] != infinity
+					&& data.distance[x] + c.weights[i] == data.distance[y]) {
+					data.parent[y] = x;
+					queue.push_back(y);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Prints shortest paths to an output file
+ * @param data: contains shortest paths to be printed
+ * @param file: output file to which shortest paths will be printed
+ * @return true if shortest paths were output to file successfuly
+ */
+bool print_sssp_to_file(const sssp_data& data, const std::string& file)
+{
+	result_writer w;
+	if (!open_writer(w, file))
+		return false;
+
+	for (size_t i = 0; i < data.distance.size(); i++) {
+		if (data.parent[i] != -1) {
+			write_text(w, "(");
+			write_int(w, data.parent[i]);
+			write_text(w, ", ");
+			write_int(w, i);
+			write_text(w, ", ");
+			write_double(w, data.distance[i]);
+			write_text(w, "),\n");
+		}
+	}
+
+	return close_writer(w);
+}
@@ -0,0 +1,398 @@
+/**
+ * @file spanning_forest.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a parallel maximum spanning forest algorithm
+ */
+#include "../include/spanning_forest.h"
+#include "../include/parallel.h"
+#include "../include/union_find.h"
+#include "../include/indexed_heap.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <vector>
+
+static const size_t no_edge = std::numeric_limits<size_t>::max(); //!< marks a component without an outgoing edge
+static const size_t vertex_grain = 1024; //!< number of vertices processed by a thread at once
+static const size_t task_vertices = 4096; //!< components at least this large are separate tasks, smaller ones are batched up to it
+
+/**
+ * Finds a vertex that a half-edge starts from
+ * @param c: graph
+ * @param i: index of a half-edge
+ * @return index of a vertex whose row contains i
+ */
+static inline int edge_source(const csr_graph& c, size_t i)
+{
+	return (int)(std::upper_bound(c.offsets, c.offsets + c.max_index + 2, i) - c.offsets) - 1;
+}
+
+/**
+ * Checks if an edge is heavier than another one. Edges of equal weight are ordered by their
+ * end vertices, so both half-edges of an undirected edge compare equal and all other edges differ.
+ * @param c: graph
+ * @param a: index of a first half-edge
+ * @param x: vertex that a starts from
+ * @param b: index of a second half-edge
+ * @param y: vertex that b starts from
+ * @return true if a is heavier than b
+ */
+static inline bool heavier(const csr_graph& c, size_t a, int x, size_t b, int y)
+{
+	if (c.weights[a] != c.weights[b])
+		return c.weights[a] > c.weights[b];
+
+	int a_lo = std::min(x, c.neighbors[a]);
+	int a_hi = std::max(x, c.neighbors[a]);
+	int b_lo = std::min(y, c.neighbors[b]);
+	int b_hi = std::max(y, c.neighbors[b]);
+
+	return a_lo < b_lo || (a_lo == b_lo && a_hi < b_hi);
+}
+
+/**
+ * Offers an edge as the heaviest outgoing edge of a component
+ * @param c: graph
+ * @param best: current heaviest outgoing edge of a component
+ * @param e: index of an offered half-edge
+ * @param x: vertex that e starts from
+ */
+static void propose_edge(const csr_graph& c, std::atomic<size_t>& best, size_t e, int x)
+{
+	size_t current = best.load(std::memory_order_relaxed);
+
+	while (current == no_edge || heavier(c, e, x, current, edge_source(c, current))) {
+		if (best.compare_exchange_weak(current, e, std::memory_order_relaxed))
+			break;
+	}
+}
+
+/**
+ * Orients edges of a spanning forest from the smallest vertex of every component: roots get
+ * distance 0 and parent -1, every other vertex the weight of the edge to its parent
+ * @param edges: edges of a forest
+ * @param has_edges: function that checks if a vertex has any edge in a graph, vertices without edges are left out
+ * @param data: data whose intree, distance and parent are filled
+ */
+template <typename HasEdges>
+static void orient_forest(const std::vector<weighted_edge>& edges, HasEdges&& has_edges, mst_data& data)
+{
+	int n = (int)data.parent.size();
+
+	csr_graph forest;
+	csr_from_edges(edges, forest);
+
+	std::queue<int> q;
+	for (int r = 0; r < n; r++) {
+		if (data.intree[r] || !has_edges(r))
+			continue;
+
+		data.intree[r] = true;
+		data.distance[r] = 0;
+		q.push(r);
+
+		while (!q.empty()) {
+			int x = q.front();
+			q.pop();
+
+			if (x > forest.max_index)
+				continue;
+
+			for_each_edge(forest, x, [&] (int y, double weight) {
+				if (!data.intree[y]) {
+					data.intree[y] = true;
+					data.distance[y] = weight;
+					data.parent[y] = x;
+					q.push(y);
+				}
+			});
+		}
+	}
+}
+
+/**
+ * Calculate a maximum spanning forest of every component of a graph using parallel Borůvka's algorithm.
+ * In every round each component picks its heaviest outgoing edge, then components are merged
+ * along the picked edges with a lock-free union-find. Edges of equal weight are ordered by their
+ * end vertices, so the picked edges never form a cycle.
+ * The forest is returned rooted at the smallest vertex of every component: roots have distance 0
+ * and parent -1, like the starting vertex of maximum_spanning_tree. Unlike Prim's algorithm,
+ * edges of zero and negative weight are also used to connect a component.
+ * @param c: graph on which maximum spanning forest will be calculated
+ * @param data: data constructed for a graph c
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ */
+void maximum_spanning_forest(const csr_graph& c, mst_data& data, int num_threads)
+{
+	int n = c.max_index + 1;
+	int threads = parallel_thread_count(num_threads);
+
+	concurrent_union_find uf(n);
+	std::unique_ptr<std::atomic<size_t>[]> best(new std::atomic<size_t>[n > 0 ? n : 0]);
+	std::vector<std::vector<weighted_edge>> picked(threads);
+
+	// only roots of components that still have outgoing edges take part in a round
+	std::vector<int> roots;
+	for (int x = 0; x < n; x++) {
+		best[x].store(no_edge, std::memory_order_relaxed);
+		if (degree(c, x) > 0)
+			roots.push_back(x);
+	}
+
+	while (!roots.empty()) {
+		parallel_for(0, n, vertex_grain, [&] (size_t begin, size_t end, int) {
+			for (int x = (int)begin; x < (int)end; x++) {
+				int rx = uf_find(uf, x);
+				size_t local = no_edge;
+
+				for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++) {
+					if (uf_find(uf, c.neighbors[i]) == rx)
+						continue;
+					if (local == no_edge || heavier(c, i, x, local, x))
+						local = i;
+				}
+
+				if (local != no_edge)
+					propose_edge(c, best[rx], local, x);
+			}
+		}, threads);
+
+		std::atomic<bool> merged(false);
+
+		parallel_for(0, roots.size(), vertex_grain, [&] (size_t begin, size_t end, int thread) {
+			for (size_t k = begin; k < end; k++) {
+				size_t e = best[roots[k]].exchange(no_edge, std::memory_order_relaxed);
+				if (e == no_edge)
+					continue;
+
+				int x = edge_source(c, e);
+				int y = c.neighbors[e];
+
+				// both components may have picked the same edge, only one of them adds it
+				if (uf_unite(uf, x, y)) {
+					picked[thread].push_back({ x, y, c.weights[e] });
+					merged.store(true, std::memory_order_relaxed);
+				}
+			}
+		}, threads);
+
+		if (!merged.load())
+			break;
+
+		roots.erase(std::remove_if(roots.begin(), roots.end(), [&] (int r) {
+			return uf_find(uf, r) != r;
+		}), roots.end());
+	}
+
+	std::vector<weighted_edge> edges;
+	for (std::vector<weighted_edge>& p : picked)
+		edges.insert(edges.end(), p.begin(), p.end());
+
+	orient_forest(edges, [&] (int x) { return degree(c, x) > 0; }, data);
+}
+
+/**
+ * Grows a maximum spanning tree of a component with Prim's algorithm and an indexed heap,
+ * until no more vertices are reachable
+ * @param c: graph
+ * @param start: starting vertex
+ * @param h: empty heap, left empty
+ * @param intree: a vector that information if a given vertex is already in a spanning tree
+ * @param data: data whose distance and parent are filled for vertices of a component
+ */
+static void grow_tree(const csr_graph& c, int start, indexed_heap& h, std::vector<char>& intree,
+	mst_data& data)
+{
+	int x = start;
+	data.distance[start] = 0;
+
+	while (true) {
+		intree[x] = true;
+
+		for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++) {
+			int y = c.neighbors[i];
+			double weight = c.weights[i];
+
+			if ((weight > data.distance[y]) && !intree[y]) {
+				data.distance[y] = weight;
+				data.parent[y] = x;
+				heap_push_or_increase(h, y, weight);
+			}
+		}
+
+		if (heap_empty(h))
+			break;
+
+		x = heap_pop(h);
+	}
+}
+
+/**
+ * Calculate a maximum spanning forest of every component of a graph by running Prim's algorithm
+ * on all components in parallel. Large components are separate tasks, small ones are batched
+ * together into tasks of a similar size. Every tree is grown from the smallest vertex of its
+ * component, so it is the tree that maximum_spanning_tree started at that vertex produces.
+ * Like maximum_spanning_tree, edges of zero and negative weight are not used.
+ * @param c: graph on which maximum spanning forest will be calculated
+ * @param component: label of each vertex, the smallest vertex of its component, from connected_components
+ * @param data: data constructed for a graph c
+ * @param num_threads: number of threads to use, 0 means all hardware threads
+ */
+void component_spanning_forest(const csr_graph& c, const std::vector<int>& component,
+	mst_data& data, int num_threads)
+{
+	int n = c.max_index + 1;
+	int threads = parallel_thread_count(num_threads);
+
+	std::vector<size_t> size(n, 0);
+	for (int x = 0; x < n; x++)
+		size[component[x]]++;
+
+	// isolated vertices are left out of the forest, as in maximum_spanning_forest
+	std::vector<int> roots;
+	for (int x = 0; x < n; x++) {
+		if (component[x] == x && degree(c, x) != 0)
+			roots.push_back(x);
+	}
+
+	std::vector<size_t> tasks;
+	size_t batch = task_vertices;
+	for (size_t k = 0; k < roots.size(); k++) {
+		if (size[roots[k]] >= task_vertices || batch >= task_vertices) {
+			tasks.push_back(k);
+			batch = 0;
+		}
+		batch += size[roots[k]];
+	}
+	tasks.push_back(roots.size());
+
+	// vector<bool> packs vertices of different components into the same word, so threads use bytes
+	std::vector<char> intree(n, false);
+	std::vector<std::unique_ptr<indexed_heap>> heaps(threads);
+
+	parallel_for(0, tasks.size() - 1, 1, [&] (size_t begin, size_t end, int thread) {
+		if (!heaps[thread])
+			heaps[thread].reset(new indexed_heap(n));
+
+		for (size_t t = begin; t < end; t++) {
+			for (size_t k = tasks[t]; k < tasks[t + 1]; k++)
+				grow_tree(c, roots[k], *heaps[thread], intree, data);
+		}
+	}, threads);
+
+	for (int x = 0; x < n; x++) {
+		if (intree[x])
+			data.intree[x] = true;
+	}
+}
+
+/**
+ * Checks if an edge x <--> y of weight w is heavier than an edge a <--> b of weight v, ordering edges
+ * of equal weight by their end vertices like heavier does
+ * @return true if the first edge is heavier
+ */
+static inline bool heavier_edge(double w, int x, int y, double v, int a, int b)
+{
+	if (w != v)
+		return w > v;
+
+	int lo = std::min(x, y);
+	int hi = std::max(x, y);
+	int other_lo = std::min(a, b);
+	int other_hi = std::max(a, b);
+
+	return lo < other_lo || (lo == other_lo && hi < other_hi);
+}
+
+/**
+ * Calculate a maximum spanning forest of a semi-external graph with Borůvka's algorithm.
+ * Every round streams rows of the graph from disk in sequential blocks and picks the heaviest
+ * outgoing edge of every component, only union-find and the picked edges are kept in memory.
+ * A vertex whose edges all lead inside of its component is not read again in later rounds.
+ * The forest is the same as the one of maximum_spanning_forest and is rooted the same way.
+ * The number of bytes read is left in e.bytes_read.
+ * @param e: graph on which maximum spanning forest will be calculated
+ * @param data: data constructed for a graph e
+ * @return false if reading a graph failed
+ */
+bool maximum_spanning_forest(external_graph& e, mst_data& data)
+{
+	reset_external_stats(e);
+
+	int n = e.max_index + 1;
+	concurrent_union_find uf(n);
+	external_block block;
+
+	std::vector<int> rows;
+	for (int x = 0; x < n; x++) {
+		if (degree(e, x) > 0)
+			rows.push_back(x);
+	}
+
+	std::vector<int> best_x(n, -1);
+	std::vector<int> best_y(n, -1);
+	std::vector<double> best_weight(n, 0);
+	std::vector<char> outgoing(n, false);
+	std::vector<weighted_edge> edges;
+
+	while (!rows.empty()) {
+		bool ok = scan_external_rows(e, rows, true, block, [&] (int x, const int32_t* neighbors,
+			const double* weights, size_t count) {
+			int rx = uf_find(uf, x);
+
+			for (size_t i = 0; i < count; i++) {
+				int y = neighbors[i];
+				if (uf_find(uf, y) == rx)
+					continue;
+
+				outgoing[x] = true;
+				if (best_x[rx] == -1 || heavier_edge(weights[i], x, y, best_weight[rx], best_x[rx], best_y[rx])) {
+					best_x[rx] = x;
+					best_y[rx] = y;
+					best_weight[rx] = weights[i];
+				}
+			}
+		});
+
+		if (!ok)
+			return false;
+
+		// a root may have been dropped from rows while other vertices of its component are still read
+		std::vector<int> roots;
+		for (int x : rows)
+			roots.push_back(uf_find(uf, x));
+		std::sort(roots.begin(), roots.end());
+		roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+
+		bool merged = false;
+
+		for (int r : roots) {
+			if (best_x[r] == -1)
+				continue;
+
+			// both components may have picked the same edge, only one of them adds it
+			if (uf_unite(uf, best_x[r], best_y[r])) {
+				edges.push_back({ best_x[r], best_y[r], best_weight[r] });
+				merged = true;
+			}
+		}
+
+		for (int r : roots)
+			best_x[r] = -1;
+
+		if (!merged)
+			break;
+
+		rows.erase(std::remove_if(rows.begin(), rows.end(), [&] (int x) {
+			bool keep = outgoing[x];
+			outgoing[x] = false;
+			return !keep;
+		}), rows.end());
+	}
+
+	orient_forest(edges, [&] (int x) { return degree(e, x) > 0; }, data);
+	return true;
+}
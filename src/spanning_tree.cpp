@@ -4,58 +4,101 @@
  * @brief File contains implementation of a maximum spanning tree algorithm
  */
 #include "../include/spanning_tree.h"
+#include "../include/indexed_heap.h"
+#include "../include/stats.h"
 
 #include <iostream>
-#include <fstream>
 #include <vector>
 #include <limits>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 
 /**
  * Constucts maximum spanning tree's data
  * @param g: maximum spanning tree's data to be constructed.
  */
-mst_data::mst_data(graph& g)
+template <typename Vertex, typename Weight>
+basic_mst_data<Vertex, Weight>::basic_mst_data(basic_graph<Vertex, Weight>& g)
 	:intree(g.max_index + 1, false),
-	 distance(g.max_index + 1, std::numeric_limits<double>::min()),
+	 distance(g.max_index + 1, std::numeric_limits<Weight>::min()),
 	 parent(g.max_index + 1, -1)
 {
 }
 
+/**
+ * Constucts maximum spanning tree's data for a compressed sparse row graph
+ * @param c: graph on which algorithm will run
+ */
+template <typename Vertex, typename Weight>
+basic_mst_data<Vertex, Weight>::basic_mst_data(const csr_graph& c)
+	:intree(c.max_index + 1, false),
+	 distance(c.max_index + 1, std::numeric_limits<Weight>::min()),
+	 parent(c.max_index + 1, -1)
+{
+}
+
+/**
+ * Constucts maximum spanning tree's data for a compressed graph
+ * @param z: graph on which algorithm will run
+ */
+template <typename Vertex, typename Weight>
+basic_mst_data<Vertex, Weight>::basic_mst_data(const compressed_graph& z)
+	:intree(z.max_index + 1, false),
+	 distance(z.max_index + 1, std::numeric_limits<Weight>::min()),
+	 parent(z.max_index + 1, -1)
+{
+}
+
+/**
+ * Constucts maximum spanning tree's data for a semi-external graph
+ * @param e: graph on which algorithm will run
+ */
+template <typename Vertex, typename Weight>
+basic_mst_data<Vertex, Weight>::basic_mst_data(const external_graph& e)
+	:intree(e.max_index + 1, false),
+	 distance(e.max_index + 1, std::numeric_limits<Weight>::min()),
+	 parent(e.max_index + 1, -1)
+{
+}
+
 /**
  * Calculate a maximum spanning tree for a given graph using Prim's algorithm
  * @param g: graph on which minimum spanning tree will be calculated
  * @param start: arbitrary starting index
- * @param data: data needed to run an algorithm
  * @param intree: a vector that information if a given vertex is already in a spanning tree
  * @param distance: a vector that information of a weight of a vertex in a spanning tree
  * @param parent: a vector that holds an index of a parent vertex for each of vertices
  */
-void maximum_spanning_tree_impl(graph& g, int start, std::vector<bool>& intree,
-	std::vector<double>& distance, std::vector<int>& parent)
+template <typename Graph, typename Vertex, typename Weight>
+void maximum_spanning_tree_impl(const Graph& g, Vertex start, std::vector<bool>& intree,
+	std::vector<Weight>& distance, std::vector<Vertex>& parent)
 {
-	int x;
-	int y;
-	double weight;
-	double dist;
+	Vertex x;
+	Weight dist;
+
+	GAL_STATS_BEGIN(stats);
+	GAL_STATS_PHASE(stats, "mst dense");
 
 	distance[start] = 0;
 	x = start;
 
 	while (intree[x] == false) {
 		intree[x] = true;
+		GAL_STATS_ADD(stats, vertices_discovered, 1);
 
-		for (edge* p = g.edges[x]; p != nullptr; p = p->next) {
-			y = p->y;
-			weight = p->weight;
+		for_each_edge(g, x, [&] (Vertex y, Weight weight) {
+			GAL_STATS_ADD(stats, edges_scanned, 1);
 			if ((weight > distance[y]) && (intree[y] == false)) {
 				distance[y] = weight;
 				parent[y] = x;
 			}
-		}
+		});
 		x = 0;
-		dist = std::numeric_limits<double>::min();
+		dist = std::numeric_limits<Weight>::min();
+		GAL_STATS_ADD(stats, scan_steps, g.max_index + 1);
 
-		for (int i = 0; i <= g.max_index; i++) {
+		for (Vertex i = 0; i <= g.max_index; i++) {
 			if ((intree[i] == false) && (dist < distance[i])) {
 				dist = distance[i];
 				x = i;
@@ -65,37 +108,201 @@ void maximum_spanning_tree_impl(graph& g, int start, std::vector<bool>& intree,
 }
 
 /**
- * Calculate a maximum spanning tree for a given graph using Prim's algorithm
+ * Calculate a maximum spanning tree for a given graph using Prim's algorithm with an indexed heap.
+ * The heap pops a vertex with the greatest distance and the smallest index among equal distances,
+ * which is the vertex the linear scan of maximum_spanning_tree_impl picks.
+ * @param g: graph on which minimum spanning tree will be calculated
+ * @param start: arbitrary starting index
+ * @param intree: a vector that information if a given vertex is already in a spanning tree
+ * @param distance: a vector that information of a weight of a vertex in a spanning tree
+ * @param parent: a vector that holds an index of a parent vertex for each of vertices
+ */
+template <typename Graph, typename Vertex, typename Weight>
+void maximum_spanning_tree_heap_impl(const Graph& g, Vertex start, std::vector<bool>& intree,
+	std::vector<Weight>& distance, std::vector<Vertex>& parent)
+{
+	basic_indexed_heap<Vertex> h(g.max_index + 1);
+	Vertex x;
+
+	GAL_STATS_BEGIN(stats);
+	GAL_STATS_PHASE(stats, "mst heap");
+
+	distance[start] = 0;
+	x = start;
+
+	while (intree[x] == false) {
+		intree[x] = true;
+		GAL_STATS_ADD(stats, vertices_discovered, 1);
+
+		for_each_edge(g, x, [&] (Vertex y, Weight weight) {
+			GAL_STATS_ADD(stats, edges_scanned, 1);
+			if ((weight > distance[y]) && (intree[y] == false)) {
+				distance[y] = weight;
+				parent[y] = x;
+				heap_push_or_increase(h, y, weight);
+			}
+		});
+
+		// like the linear scan, fall back to vertex 0 when no vertex is reachable
+		x = heap_empty(h) ? 0 : heap_pop(h);
+	}
+}
+
+/**
+ * Chooses a strategy of the Prim's algorithm from the density of a graph
+ * @param vertices: number of vertices
+ * @param half_edges: number of stored half-edges
+ * @return heap for sparse graphs, dense otherwise
+ */
+static mst_strategy choose_mst_strategy(size_t vertices, size_t half_edges)
+{
+	// linear scans cost V^2 in total, heap operations cost about E log V
+	double log_v = std::max(1.0, std::log2((double)vertices));
+
+	if ((double)half_edges * log_v < (double)vertices * (double)vertices)
+		return mst_strategy::heap;
+
+	return mst_strategy::dense;
+}
+
+/**
+ * Calculate a maximum spanning tree for a given graph using Prim's algorithm.
+ * Both strategies pick the same vertex at every step, so they produce the same tree.
  * @param g: graph on which minimum spanning tree will be calculated
  * @param start: arbitrary starting index
  * @param data: data needed to run an algorithm
+ * @param strategy: how the next vertex is picked, by default chosen from the density of a graph
  */
-void maximum_spanning_tree(graph& g, int start, mst_data& data)
+template <typename Vertex, typename Weight>
+void maximum_spanning_tree(basic_graph<Vertex, Weight>& g, typename basic_graph<Vertex, Weight>::vertex_type start,
+	basic_mst_data<Vertex, Weight>& data, mst_strategy strategy)
 {
-	maximum_spanning_tree_impl(g, start, data.intree, data.distance, data.parent);
+	if (strategy == mst_strategy::automatic)
+		strategy = choose_mst_strategy(g.max_index + 1, 2 * g.num_edges);
+
+	if (strategy == mst_strategy::heap)
+		maximum_spanning_tree_heap_impl(g, start, data.intree, data.distance, data.parent);
+	else
+		maximum_spanning_tree_impl(g, start, data.intree, data.distance, data.parent);
 }
 
 /**
- * Prints a minimum spanning tree to an input file
- * @param data: contains a minimum spanning tree to be printed
- * @param file: output file to which maximum spanning tree will be printed
- * @return true if minimum spanning tree was output to file successfuly
+ * Calculate a maximum spanning tree for a compressed sparse row graph using Prim's algorithm.
+ * Both strategies pick the same vertex at every step, so they produce the same tree.
+ * @param c: graph on which maximum spanning tree will be calculated
+ * @param start: arbitrary starting index
+ * @param data: data needed to run an algorithm
+ * @param strategy: how the next vertex is picked, by default chosen from the density of a graph
  */
-bool print_mst_to_file(mst_data& data, const std::string& file)
+void maximum_spanning_tree(const csr_graph& c, int start, mst_data& data, mst_strategy strategy)
 {
-	std::ofstream ost(file);
-	if (!ost) {
-		std::cerr << "Error: cannot open output file: " << file << std::endl;
-		return false;
+	if (strategy == mst_strategy::automatic)
+		strategy = choose_mst_strategy(c.max_index + 1, edge_count(c));
+
+	if (strategy == mst_strategy::heap)
+		maximum_spanning_tree_heap_impl(c, start, data.intree, data.distance, data.parent);
+	else
+		maximum_spanning_tree_impl(c, start, data.intree, data.distance, data.parent);
+}
+
+/**
+ * Calculate a maximum spanning tree for a compressed graph using Prim's algorithm,
+ * decoding neighbour lists on the fly.
+ * Both strategies pick the same vertex at every step, so they produce the same tree.
+ * @param z: graph on which maximum spanning tree will be calculated
+ * @param start: arbitrary starting index
+ * @param data: data needed to run an algorithm
+ * @param strategy: how the next vertex is picked, by default chosen from the density of a graph
+ */
+void maximum_spanning_tree(const compressed_graph& z, int start, mst_data& data, mst_strategy strategy)
+{
+	if (strategy == mst_strategy::automatic)
+		strategy = choose_mst_strategy(z.max_index + 1, edge_count(z));
+
+	if (strategy == mst_strategy::heap)
+		maximum_spanning_tree_heap_impl(z, start, data.intree, data.distance, data.parent);
+	else
+		maximum_spanning_tree_impl(z, start, data.intree, data.distance, data.parent);
+}
+
+/**
+ * Sums weights of all edges of a spanning tree or forest
+ * @param data: contains a spanning tree
+ * @return total weight of edges that connect vertices to their parents
+ */
+template <typename Vertex, typename Weight>
+double spanning_tree_weight(const basic_mst_data<Vertex, Weight>& data)
+{
+	double total = 0;
+
+	for (size_t i = 0; i < data.parent.size(); i++) {
+		if (data.parent[i] != -1)
+			total += data.distance[i];
 	}
 
+	return total;
+}
+
+/**
+ * Writes edges of a spanning tree or forest. Text lines are "(parent, vertex, weight),",
+ * binary records are tree edges with weights stored as floats for float weights and as doubles otherwise.
+ * @param data: contains a spanning tree
+ * @param w: open writer
+ * @param format: format of the output
+ */
+template <typename Vertex, typename Weight>
+void write_mst(const basic_mst_data<Vertex, Weight>& data, result_writer& w, result_format format)
+{
+	using stored_weight = typename std::conditional<std::is_same<Weight, float>::value, float, double>::type;
+
+	if (format == result_format::binary)
+		write_result_header(w, result_kind::tree_edges, sizeof(Vertex), sizeof(stored_weight));
+
 	for (size_t i = 0; i < data.intree.size(); i++) {
-		if (data.parent[i] != -1) {
-			ost << "(" << data.parent[i]<< ", " << i
-				<< ", " << data.distance[i] << ")," << std::endl;
+		if (data.parent[i] == -1)
+			continue;
 
+		if (format == result_format::binary) {
+			write_raw(w, data.parent[i]);
+			write_raw(w, (Vertex)i);
+			write_raw(w, (stored_weight)data.distance[i]);
+			continue;
 		}
+
+		write_text(w, "(");
+		write_int(w, data.parent[i]);
+		write_text(w, ", ");
+		write_int(w, i);
+		write_text(w, ", ");
+		write_value(w, data.distance[i]);
+		write_text(w, "),\n");
 	}
+}
 
-	return true;
+/**
+ * Prints a minimum spanning tree to an input file
+ * @param data: contains a minimum spanning tree to be printed
+ * @param file: output file to which maximum spanning tree will be printed, "-" for the standard output
+ * @param format: format of the output
+ * @return true if minimum spanning tree was output to file successfuly
+ */
+template <typename Vertex, typename Weight>
+bool print_mst_to_file(basic_mst_data<Vertex, Weight>& data, const std::string& file, result_format format)
+{
+	result_writer w;
+	if (!open_writer(w, file))
+		return false;
+
+	write_mst(data, w, format);
+	return close_writer(w);
 }
+
+//! instantiates spanning trees on an adjacency list graph for a type of vertex indices and a type of weights
+#define GAL_INSTANTIATE_MST(V, W) \
+	template struct basic_mst_data<V, W>; \
+	template void maximum_spanning_tree<V, W>(basic_graph<V, W>&, V, basic_mst_data<V, W>&, mst_strategy); \
+	template double spanning_tree_weight<V, W>(const basic_mst_data<V, W>&); \
+	template void write_mst<V, W>(const basic_mst_data<V, W>&, result_writer&, result_format); \
+	template bool print_mst_to_file<V, W>(basic_mst_data<V, W>&, const std::string&, result_format);
+
+GAL_GRAPH_TYPES(GAL_INSTANTIATE_MST)
@@ -0,0 +1,230 @@
+/**
+ * @file stats.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of optional counters and timers of algorithm runs
+ */
+#include "../include/stats.h"
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+/**
+ * Creates empty statistics
+ * @param hardware: true to also read hardware counters with perf_event_open where available
+ */
+run_stats::run_stats(bool hardware)
+	:edges_scanned(0), vertices_discovered(0), heap_pushes(0), heap_increases(0), heap_pops(0),
+	 scan_steps(0), hardware(hardware), cycles(-1), instructions(-1), cache_misses(-1),
+	 origin(std::chrono::steady_clock::now())
+{
+}
+
+/**
+ * Returns the time elapsed since a run started
+ * @param s: statistics of a run
+ * @return time in microseconds
+ */
+double stats_elapsed_us(const run_stats& s)
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - s.origin).count();
+}
+
+/**
+ * Returns statistics of a breadth-first search level, creating the levels up to it
+ * @param s: statistics of a run
+ * @param level: depth of a level
+ * @return statistics of a level
+ */
+level_stats& stats_level(run_stats& s, size_t level)
+{
+	while (s.levels.size() <= level) {
+		s.levels.emplace_back();
+		s.levels.back().start_us = stats_elapsed_us(s);
+	}
+	return s.levels[level];
+}
+
+/**
+ * Opens a hardware counter of the calling thread, counting user space only
+ * @param config: kind of a counter, one of PERF_COUNT_HW_*
+ * @return file descriptor of a counter, -1 if it cannot be opened
+ */
+static int open_counter(unsigned long long config)
+{
+#ifdef __linux__
+	perf_event_attr attr;
+	std::memset(&attr, 0, sizeof(attr));
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.size = sizeof(attr);
+	attr.config = config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+
+	int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+	if (fd != -1) {
+		ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+	return fd;
+#else
+	(void)config;
+	return -1;
+#endif
+}
+
+/**
+ * Reads and closes a hardware counter
+ * @param fd: file descriptor of a counter, -1 if it was not opened
+ * @return value of a counter, -1 if not available
+ */
+static long long close_counter(int fd)
+{
+#ifdef __linux__
+	if (fd == -1)
+		return -1;
+
+	long long value = -1;
+	ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+	if (read(fd, &value, sizeof(value)) != sizeof(value))
+		value = -1;
+	close(fd);
+	return value;
+#else
+	(void)fd;
+	return -1;
+#endif
+}
+
+/**
+ * Starts collecting statistics of a run
+ * @param s: statistics to be filled
+ */
+stats_scope::stats_scope(run_stats& s)
+	:stats(s), previous(current_stats()), counters{ -1, -1, -1 }
+{
+	s.origin = std::chrono::steady_clock::now();
+	current_stats() = &s;
+
+	// counters are unavailable without permissions or in most virtual machines, which is not an error
+	if (s.hardware) {
+#ifdef __linux__
+		counters[0] = open_counter(PERF_COUNT_HW_CPU_CYCLES);
+		counters[1] = open_counter(PERF_COUNT_HW_INSTRUCTIONS);
+		counters[2] = open_counter(PERF_COUNT_HW_CACHE_MISSES);
+#endif
+	}
+}
+
+/**
+ * Stops collecting statistics and reads hardware counters
+ */
+stats_scope::~stats_scope()
+{
+	if (stats.hardware) {
+		stats.cycles = close_counter(counters[0]);
+		stats.instructions = close_counter(counters[1]);
+		stats.cache_misses = close_counter(counters[2]);
+	}
+
+	current_stats() = previous;
+}
+
+/**
+ * Starts a phase
+ * @param s: active statistics, nullptr if none
+ * @param name: name of a phase
+ */
+stats_phase_timer::stats_phase_timer(run_stats* s, const char* name)
+	:stats(s), index(0)
+{
+	if (s == nullptr)
+		return;
+
+	index = s->phases.size();
+	s->phases.push_back({ name, stats_elapsed_us(*s), 0 });
+}
+
+/**
+ * Ends a phase
+ */
+stats_phase_timer::~stats_phase_timer()
+{
+	if (stats == nullptr)
+		return;
+
+	phase_stats& p = stats->phases[index];
+	p.duration_us = stats_elapsed_us(*stats) - p.start_us;
+}
+
+/**
+ * Prints a single counter event of a trace
+ * @param ost: output stream
+ * @param name: name of a counter
+ * @param ts: time of an event in microseconds
+ * @param value: value of a counter
+ */
+static void print_counter(std::ostream& ost, const std::string& name, double ts, double value)
+{
+	ost << ",\n  {\"name\": \"" << name << "\", \"ph\": \"C\", \"ts\": " << ts
+		<< ", \"pid\": 1, \"tid\": 1, \"args\": {\"value\": " << value << "}}";
+}
+
+/**
+ * Prints statistics as Chrome trace event JSON, viewable in chrome://tracing or Perfetto.
+ * Phases become complete events, levels and counters become counter events.
+ * @param s: statistics of a run
+ * @param file: output file
+ * @return true if statistics were written successfuly
+ */
+bool print_stats_trace(const run_stats& s, const std::string& file)
+{
+	std::ofstream ost(file);
+	if (!ost) {
+		std::cerr << "Error: cannot open output file: " << file << std::endl;
+		return false;
+	}
+
+	double end = 0;
+
+	ost << "{\"traceEvents\": [\n  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, "
+		<< "\"args\": {\"name\": \"graph algorithms\"}}";
+
+	for (const phase_stats& p : s.phases) {
+		ost << ",\n  {\"name\": \"" << p.name << "\", \"ph\": \"X\", \"ts\": " << p.start_us
+			<< ", \"dur\": " << p.duration_us << ", \"pid\": 1, \"tid\": 1}";
+		end = std::max(end, p.start_us + p.duration_us);
+	}
+
+	for (size_t i = 0; i < s.levels.size(); i++) {
+		print_counter(ost, "frontier", s.levels[i].start_us, (double)s.levels[i].frontier);
+		print_counter(ost, "level edges", s.levels[i].start_us, (double)s.levels[i].edges);
+	}
+
+	print_counter(ost, "edges scanned", end, (double)s.edges_scanned);
+	print_counter(ost, "vertices discovered", end, (double)s.vertices_discovered);
+	print_counter(ost, "heap pushes", end, (double)s.heap_pushes);
+	print_counter(ost, "heap increases", end, (double)s.heap_increases);
+	print_counter(ost, "heap pops", end, (double)s.heap_pops);
+	print_counter(ost, "scan steps", end, (double)s.scan_steps);
+
+	if (s.cycles != -1)
+		print_counter(ost, "cycles", end, (double)s.cycles);
+	if (s.instructions != -1)
+		print_counter(ost, "instructions", end, (double)s.instructions);
+	if (s.cache_misses != -1)
+		print_counter(ost, "cache misses", end, (double)s.cache_misses);
+
+	ost << "\n]}" << std::endl;
+
+	return true;
+}
@@ -0,0 +1,17 @@
+/**
+ * @file union_find.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a lock-free union-find data structure
+ */
+#include "../include/union_find.h"
+
+/**
+ * Creates n singleton sets
+ * @param n: number of vertices
+ */
+concurrent_union_find::concurrent_union_find(int n)
+	:size(n), parent(new std::atomic<int>[n > 0 ? n : 0])
+{
+	for (int i = 0; i < n; i++)
+		parent[i].store(i, std::memory_order_relaxed);
+}
@@ -0,0 +1,163 @@
+/**
+ * @file workspace.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of reusable traversal workspaces and a pool of them
+ */
+#include "../include/workspace.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+/**
+ * Creates a workspace for graphs with n vertices
+ * @param n: number of vertices, max_index + 1
+ */
+traversal_workspace::traversal_workspace(int n)
+	:epoch(0), discovered(n, 0), processed(n, 0), parent(n, -1), depth(n, -1),
+	 distance(n, std::numeric_limits<double>::min()), heap(n)
+{
+}
+
+/**
+ * Starts a new run, forgetting the previous one in time proportional to the vertices it touched
+ * @param ws: workspace
+ */
+void reset_workspace(traversal_workspace& ws)
+{
+	ws.touched.clear();
+	ws.stack.clear();
+
+	// stamps of old runs would become valid again after the epoch wraps around
+	if (++ws.epoch == 0) {
+		std::fill(ws.discovered.begin(), ws.discovered.end(), 0);
+		std::fill(ws.processed.begin(), ws.processed.end(), 0);
+		ws.epoch = 1;
+	}
+}
+
+/**
+ * Breadth-first search that keeps its state in a workspace, without hooks
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param ws: workspace, reset before the run
+ */
+void bfs(const csr_graph& c, int start, traversal_workspace& ws)
+{
+	bfs(c, start, ws, null_visitor());
+}
+
+/**
+ * Depth-first search that keeps its state in a workspace, without hooks
+ * @param c: graph to be traversed
+ * @param start: starting vertex
+ * @param ws: workspace, reset before the run
+ */
+void dfs(const csr_graph& c, int start, traversal_workspace& ws)
+{
+	dfs(c, start, ws, null_visitor());
+}
+
+/**
+ * Calculate a maximum spanning tree of the component of a starting vertex using Prim's algorithm
+ * with a heap, keeping its state in a workspace. Vertices in a tree are processed, and their parent
+ * and distance hold the tree edges. Unlike maximum_spanning_tree, the run stops when the component
+ * is spanned and does not continue from vertex 0.
+ * @param c: graph on which maximum spanning tree will be calculated
+ * @param start: starting vertex
+ * @param ws: workspace, reset before the run
+ */
+void maximum_spanning_tree(const csr_graph& c, int start, traversal_workspace& ws)
+{
+	reset_workspace(ws);
+	discover(ws, start, -1, 0);
+	ws.distance[start] = 0;
+
+	int x = start;
+
+	while (true) {
+		ws.processed[x] = ws.epoch;
+
+		for (size_t i = c.offsets[x]; i < c.offsets[x + 1]; i++) {
+			int y = c.neighbors[i];
+			double weight = c.weights[i];
+
+			if (is_processed(ws, y))
+				continue;
+
+			// a vertex that is not discovered yet has the initial distance of mst_data
+			if (!is_discovered(ws, y)) {
+				discover(ws, y, -1, ws.depth[x] + 1);
+				ws.distance[y] = std::numeric_limits<double>::min();
+			}
+
+			if (weight > ws.distance[y]) {
+				ws.distance[y] = weight;
+				ws.parent[y] = x;
+				heap_push_or_increase(ws.heap, y, weight);
+			}
+		}
+
+		if (heap_empty(ws.heap))
+			break;
+
+		x = heap_pop(ws.heap);
+	}
+}
+
+/**
+ * Creates an empty pool for graphs with n vertices, workspaces are created on demand
+ * @param n: number of vertices, max_index + 1
+ */
+workspace_pool::workspace_pool(int n)
+	:vertices(n)
+{
+}
+
+/**
+ * Checks out a workspace from a pool, creating a new one if all of them are in use
+ * @param pool: pool of workspaces
+ * @return workspace owned by a caller until it is returned with release_workspace
+ */
+std::unique_ptr<traversal_workspace> acquire_workspace(workspace_pool& pool)
+{
+	{
+		std::lock_guard<std::mutex> guard(pool.lock);
+		if (!pool.idle.empty()) {
+			std::unique_ptr<traversal_workspace> ws = std::move(pool.idle.back());
+			pool.idle.pop_back();
+			return ws;
+		}
+	}
+
+	// allocating a new workspace is slow, so it is done outside of the lock
+	return std::unique_ptr<traversal_workspace>(new traversal_workspace(pool.vertices));
+}
+
+/**
+ * Returns a workspace to a pool
+ * @param pool: pool that a workspace was acquired from
+ * @param ws: workspace to be returned
+ */
+void release_workspace(workspace_pool& pool, std::unique_ptr<traversal_workspace> ws)
+{
+	std::lock_guard<std::mutex> guard(pool.lock);
+	pool.idle.push_back(std::move(ws));
+}
+
+/**
+ * Checks out a workspace
+ * @param pool: pool of workspaces
+ */
+workspace_lease::workspace_lease(workspace_pool& pool)
+	:pool(pool), ws(acquire_workspace(pool))
+{
+}
+
+/**
+ * Returns a workspace to its pool
+ */
+workspace_lease::~workspace_lease()
+{
+	release_workspace(pool, std::move(ws));
+}
@@ -4,19 +4,32 @@
  * @brief File contains implementation of a main function, command-line arguments and files handling
  */
 #include <iostream>
-#include <fstream>
 #include <getopt.h>
 #include <string>
 #include <iomanip>
+#include <optional>
+#include <cstdlib>
 #include "../include/graph.h"
+#include "../include/csr_graph.h"
+#include "../include/graph_snapshot.h"
+#include "../include/external_graph.h"
 #include "../include/bfs.h"
+#include "../include/result_writer.h"
+#include "../include/stats.h"
 
 std::string help =
 R"(Traverse input graph using breadth-first search algorithm.
 Usage: bfs [OPTION]...
 Program options:
---input -i=<val>:            input file containg the graph description.
+--input -i=<val>:            input file containg the graph description or its binary snapshot.
 --start -s=<val>:            starting index of the provided input graph.
+--output -o=<val>:           output file of visited vertices and edges, the standard output by default.
+--parents -P=<val>:          output file of the parent of every visited vertex.
+--format -f=<val>:           format of output files, one of: text, binary, text by default.
+--external -x:               read edges of a binary snapshot from disk during the search instead of loading it,
+                             the search is level-synchronous and visits each level in increasing order.
+--block -b=<val>:            number of bytes of neighbours read at once with --external, 4 MiB by default.
+--trace -T=<val>:            output file of a Chrome trace of the run, needs a build with GAL_STATS.
 --help -h:                   show help
 )";
 
@@ -33,17 +46,29 @@ int main(int argc, char** argv)
 		return 0;
     }
 
-    const char* const short_opts = "i:s:";
+    const char* const short_opts = "i:s:o:P:f:xb:T:";
 
     const option long_opts[] = {
         {"input", required_argument, nullptr, 'i'},
         {"start", required_argument, nullptr, 's'},
+        {"output", required_argument, nullptr, 'o'},
+        {"parents", required_argument, nullptr, 'P'},
+        {"format", required_argument, nullptr, 'f'},
+        {"external", no_argument, nullptr, 'x'},
+        {"block", required_argument, nullptr, 'b'},
+        {"trace", required_argument, nullptr, 'T'},
         {nullptr, no_argument, nullptr, 0}
     };
 
 	bool has_ifile = false;
 	bool has_start = false;
 	std::string input_file_name;
+	std::string output_file_name = "-";
+	std::string parents_file_name;
+	result_format format = result_format::text;
+	bool external = false;
+	size_t block_bytes = default_external_block;
+	std::string trace_file_name;
 	int start = 0;
 
     while (true) {
@@ -60,6 +85,27 @@ int main(int argc, char** argv)
 		case 's':
 			start = std::atoi(optarg);
 			has_start = true;
+        break;
+		case 'o':
+			output_file_name = optarg;
+        break;
+		case 'P':
+			parents_file_name = optarg;
+        break;
+		case 'f':
+			if (!parse_result_format(optarg, format)) {
+				std::cerr << "Error: unknown output format: " << optarg << std::endl;
+				return 0;
+			}
+        break;
+		case 'x':
+			external = true;
+        break;
+		case 'b':
+			block_bytes = std::strtoull(optarg, nullptr, 10);
+        break;
+		case 'T':
+			trace_file_name = optarg;
         break;
         case 'h':
         case '?':
@@ -80,25 +126,67 @@ int main(int argc, char** argv)
 		return 0;
     }
 
-	graph g;
+#ifndef GAL_STATS
+	if (!trace_file_name.empty()) {
+		std::cerr << "Error: statistics are not collected without GAL_STATS" << std::endl;
+		return 0;
+	}
+#endif
+
+	csr_graph c;
+	external_graph e;
+
+	if (external) {
+		if (open_external_graph(input_file_name, e, block_bytes) == false)
+			return 0;
+	} else if (load_graph(input_file_name, c) == false) {
+		return 0;
+	}
+
+	result_writer events;
 
-	if (graph_from_file(input_file_name, g) == false)
+	if (open_writer(events, output_file_name) == false)
 		return 0;
 
-	auto process_vertex_early = [&] (int v) {
-		std::cout << "visiting vertex: " << v << std::endl;
-	};
-	auto process_edge = [&] (int x, int y) {
-		std::cout << "visiting edge: (" << x << ", " << y << ")" << std::endl;
-	};
-	auto process_vertex_late = [&] (int v) {
-		std::cout << "exiting vertex: " << v << std::endl;
-	};
+	event_writer<int> visitor(events, format);
+	bfs_data data = external ? bfs_data(e) : bfs_data(c);
+	// statistics and hardware counters are collected only for a trace
+	bool trace = !trace_file_name.empty();
+	run_stats stats(trace);
+	bool ok = true;
+
+	{
+		std::optional<stats_scope> scope;
+		if (trace)
+			scope.emplace(stats);
+		if (external)
+			ok = bfs(e, start, data, visitor);
+		else
+			bfs(c, start, data, visitor);
+	}
+
+	if (close_writer(events) == false || ok == false)
+		return 0;
+
+	if (external)
+		std::cerr << "read " << e.bytes_read << " bytes in " << e.reads << " reads" << std::endl;
+
+	if (!parents_file_name.empty()) {
+		result_writer parents;
 
-	bfs_data data(g, process_vertex_early, process_edge, process_vertex_late);
+		if (open_writer(parents, parents_file_name) == false)
+			return 0;
+
+		write_parents(data.parent, parents, format);
 
-    bfs(g, start, data);
+		if (close_writer(parents) == false)
+			return 0;
+	}
+
+	if (!trace_file_name.empty()) {
+		if (print_stats_trace(stats, trace_file_name) == false)
+			return 0;
+	}
 
-	free_graph(g);
 	return 0;
 }
@@ -4,19 +4,24 @@
  * @brief File contains implementation of a main function, command-line arguments and files handling
  */
 #include <iostream>
-#include <fstream>
 #include <getopt.h>
 #include <string>
 #include <iomanip>
 #include "../include/graph.h"
+#include "../include/csr_graph.h"
+#include "../include/graph_snapshot.h"
 #include "../include/dfs.h"
+#include "../include/result_writer.h"
 
 std::string help =
 R"(Traverse input graph using depth-first search algorithm.
 Usage: dfs [OPTION]...
 Program options:
---input -i=<val>:            input file containg the graph description.
+--input -i=<val>:            input file containg the graph description or its binary snapshot.
 --start -s=<val>:            starting index of the provided input graph.
+--output -o=<val>:           output file of visited vertices and edges, the standard output by default.
+--parents -P=<val>:          output file of the parent of every visited vertex.
+--format -f=<val>:           format of output files, one of: text, binary, text by default.
 --help -h:                   show help
 )";
 
@@ -33,17 +38,23 @@ int main(int argc, char** argv)
 		return 0;
     }
 
-    const char* const short_opts = "i:s:";
+    const char* const short_opts = "i:s:o:P:f:";
 
     const option long_opts[] = {
         {"input", required_argument, nullptr, 'i'},
         {"start", required_argument, nullptr, 's'},
+        {"output", required_argument, nullptr, 'o'},
+        {"parents", required_argument, nullptr, 'P'},
+        {"format", required_argument, nullptr, 'f'},
         {nullptr, no_argument, nullptr, 0}
     };
 
 	bool has_ifile = false;
 	bool has_start = false;
 	std::string input_file_name;
+	std::string output_file_name = "-";
+	std::string parents_file_name;
+	result_format format = result_format::text;
 	int start = 0;
 
     while (true) {
@@ -60,6 +71,18 @@ int main(int argc, char** argv)
 		case 's':
 			start = std::atoi(optarg);
 			has_start = true;
+        break;
+		case 'o':
+			output_file_name = optarg;
+        break;
+		case 'P':
+			parents_file_name = optarg;
+        break;
+		case 'f':
+			if (!parse_result_format(optarg, format)) {
+				std::cerr << "Error: unknown output format: " << optarg << std::endl;
+				return 0;
+			}
         break;
         case 'h':
         case '?':
@@ -80,26 +103,36 @@ int main(int argc, char** argv)
 		return 0;
     }
 
-	graph g;
+	csr_graph c;
 
-	if (graph_from_file(input_file_name, g) == false)
+	if (load_graph(input_file_name, c) == false)
 		return 0;
 
-	auto process_vertex_early = [&] (int v) {
-		std::cout << "visiting vertex: " << v << std::endl;
-	};
-	auto process_edge = [&] (int x, int y) {
-		std::cout << "visiting edge: (" << x << ", " << y << ")" << std::endl;
-	};
-	auto process_vertex_late = [&] (int v) {
-		std::cout << "exiting vertex: " << v << std::endl;
-	};
+	result_writer events;
 
-	dfs_data data(g, process_vertex_early, process_edge, process_vertex_late);
+	if (open_writer(events, output_file_name) == false)
+		return 0;
 
-    dfs(g, start, data);
+	event_writer<int> visitor(events, format);
+	dfs_data data(c);
+
+    dfs(c, start, data, visitor);
+
+	if (close_writer(events) == false)
+		return 0;
+
+	if (!parents_file_name.empty()) {
+		result_writer parents;
+
+		if (open_writer(parents, parents_file_name) == false)
+			return 0;
+
+		write_parents(data.parent, parents, format);
+
+		if (close_writer(parents) == false)
+			return 0;
+	}
 
-	free_graph(g);
 	return 0;
 }
 
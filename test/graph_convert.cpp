@@ -0,0 +1,91 @@
+/**
+ * @file graph_convert.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a main function of a tool that converts graphs into binary snapshots
+ */
+#include <iostream>
+#include <getopt.h>
+#include <string>
+#include "../include/graph.h"
+#include "../include/csr_graph.h"
+#include "../include/graph_snapshot.h"
+
+std::string help =
+R"(Convert the provided input graph into a binary snapshot
+Usage: graphconvert [OPTION]...
+Program options:
+--input -i=<val>:            input file containg the graph description or its binary snapshot.
+--output -o=<val>:           output file to which the binary snapshot will be written.
+--help -h:                   show help
+)";
+
+/**
+ * Main program's function
+ * @param argc: number of command line arguments
+ * @param argv: an array of command line arguments
+ * @return return zero on program's exit
+ */
+int main(int argc, char** argv)
+{
+	if (argc == 1) {
+		std::cerr << help;
+		return 0;
+	}
+
+	const char* const short_opts = "i:o:h";
+
+	const option long_opts[] = {
+		{"input", required_argument, nullptr, 'i'},
+		{"output", required_argument, nullptr, 'o'},
+		{"help", no_argument, nullptr, 'h'},
+		{nullptr, no_argument, nullptr, 0}
+	};
+
+	bool has_ifile = false;
+	bool has_ofile = false;
+	std::string input_file_name;
+	std::string output_file_name;
+
+	while (true) {
+		const auto opt = getopt_long(argc, argv, short_opts, long_opts, nullptr);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'i':
+			input_file_name = optarg;
+			has_ifile = true;
+			break;
+		case 'o':
+			output_file_name = optarg;
+			has_ofile = true;
+			break;
+		case 'h':
+		case '?':
+		default:
+			std::cout << help << std::endl;
+			return 0;
+		}
+	}
+
+	if (!has_ifile) {
+		std::cerr << "Error: input file not provided" << std::endl;
+		return 0;
+	}
+
+	if (!has_ofile) {
+		std::cerr << "Error: output file not provided" << std::endl;
+		return 0;
+	}
+
+	csr_graph c;
+
+	if (load_graph(input_file_name, c) == false)
+		return 0;
+
+	if (save_graph_binary(c, output_file_name) == false)
+		return 0;
+
+	return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file graph_query.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a main function of a client of the graph query server
+ */
+#include <iostream>
+#include <cstdlib>
+#include <getopt.h>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../include/latency_histogram.h"
+#include "../include/query_protocol.h"
+
+std::string help =
+R"(Send a query to a running graph server and print its answer
+Usage: graphquery [OPTION]...
+Program options:
+--socket -s=<val>:           path of a Unix domain socket of a server.
+--query -q=<val>:            kind of a query, one of: info, bfs, reach, path, mst, latency.
+--graph -g=<val>:            index of a graph of a server, 0 by default.
+--source -a=<val>:           starting vertex, or the kind of queries for latency, 0 by default.
+--target -b=<val>:           destination vertex of reach and path queries, 0 by default.
+--help -h:                   show help
+)";
+
+static const char* const status_names[] = {
+	"ok", "unknown query", "unknown graph", "vertex not in graph"
+}; //!< messages of every query_status
+
+/**
+ * Main program's function
+ * @param argc: number of command line arguments
+ * @param argv: an array of command line arguments
+ * @return return zero on program's exit
+ */
+int main(int argc, char** argv)
+{
+	if (argc == 1) {
+		std::cerr << help;
+		return 0;
+	}
+
+	const char* const short_opts = "s:q:g:a:b:h";
+
+	const option long_opts[] = {
+		{"socket", required_argument, nullptr, 's'},
+		{"query", required_argument, nullptr, 'q'},
+		{"graph", required_argument, nullptr, 'g'},
+		{"source", required_argument, nullptr, 'a'},
+		{"target", required_argument, nullptr, 'b'},
+		{"help", no_argument, nullptr, 'h'},
+		{nullptr, no_argument, nullptr, 0}
+	};
+
+	query_op op = query_op::info;
+	bool has_query = false;
+	std::string socket_path;
+	std::string source = "0";
+	query_request request = {};
+
+	while (true) {
+		const auto opt = getopt_long(argc, argv, short_opts, long_opts, nullptr);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 's':
+			socket_path = optarg;
+			break;
+		case 'q':
+			if (!parse_query_op(optarg, op)) {
+				std::cerr << "Error: unknown query: " << optarg << std::endl;
+				return 0;
+			}
+			has_query = true;
+			break;
+		case 'g':
+			request.graph = std::atoi(optarg);
+			break;
+		case 'a':
+			source = optarg;
+			break;
+		case 'b':
+			request.target = std::atoll(optarg);
+			break;
+		case 'h':
+		case '?':
+		default:
+			std::cout << help << std::endl;
+			return 0;
+		}
+	}
+
+	if (socket_path.empty()) {
+		std::cerr << "Error: socket path not provided" << std::endl;
+		return 0;
+	}
+
+	if (!has_query) {
+		std::cerr << "Error: query not provided" << std::endl;
+		return 0;
+	}
+
+	request.op = static_cast<uint32_t>(op);
+	request.source = std::atoll(source.c_str());
+
+	// latency queries name the kind of queries instead of a vertex
+	query_op latency_of;
+	if (op == query_op::latency && parse_query_op(source, latency_of))
+		request.source = static_cast<int64_t>(latency_of);
+
+	int fd = connect_server(socket_path);
+	if (fd < 0)
+		return 0;
+
+	query_response response;
+	std::vector<int64_t> items;
+
+	bool ok = run_query(fd, request, response, items);
+	close(fd);
+
+	if (!ok) {
+		std::cerr << "Error: connection to server failed" << std::endl;
+		return 0;
+	}
+
+	if (response.status != (uint32_t)query_status::ok) {
+		const char* message = response.status < 4 ? status_names[response.status] : "unknown status";
+		std::cerr << "Error: " << message << std::endl;
+		return 0;
+	}
+
+	std::cout << query_op_name(op) << ": vertices " << response.vertices << ", value " << response.value << std::endl;
+
+	if (op == query_op::latency) {
+		latency_histogram h;
+		for (size_t b = 0; b < items.size() && b < (size_t)latency_buckets; b++)
+			h.buckets[b].store(items[b]);
+		h.count.store(response.vertices);
+		h.total_ns.store((uint64_t)(response.value * response.vertices));
+		if (items.size() > (size_t)latency_buckets)
+			h.max_ns.store(items[latency_buckets]);
+
+		print_latency(h, query_op_name(static_cast<query_op>(request.source)), std::cout);
+		return 0;
+	}
+
+	for (size_t i = 0; i < items.size(); i++)
+		std::cout << (i == 0 ? "" : " ") << items[i];
+	if (!items.empty())
+		std::cout << std::endl;
+
+	return 0;
+}
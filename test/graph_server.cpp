@@ -0,0 +1,115 @@
+/**
+ * @file graph_server.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a main function of a daemon that answers queries on graphs kept in memory
+ */
+#include <iostream>
+#include <cstdlib>
+#include <getopt.h>
+#include <signal.h>
+#include <string>
+#include <vector>
+#include "../include/graph_server.h"
+
+std::string help =
+R"(Load graphs once and answer bfs, reach, path and mst queries on them over a Unix domain socket until interrupted
+Usage: graphserver [OPTION]...
+Program options:
+--input -i=<val>:            input file containg a graph description or its binary snapshot, may be repeated, graphs are numbered from 0.
+--socket -s=<val>:           path of a Unix domain socket to listen on.
+--threads -t=<val>:          number of worker threads, all hardware threads by default.
+--help -h:                   show help
+)";
+
+/**
+ * Main program's function
+ * @param argc: number of command line arguments
+ * @param argv: an array of command line arguments
+ * @return return zero on program's exit
+ */
+int main(int argc, char** argv)
+{
+	if (argc == 1) {
+		std::cerr << help;
+		return 0;
+	}
+
+	const char* const short_opts = "i:s:t:h";
+
+	const option long_opts[] = {
+		{"input", required_argument, nullptr, 'i'},
+		{"socket", required_argument, nullptr, 's'},
+		{"threads", required_argument, nullptr, 't'},
+		{"help", no_argument, nullptr, 'h'},
+		{nullptr, no_argument, nullptr, 0}
+	};
+
+	int threads = 0;
+	std::vector<std::string> input_file_names;
+	std::string socket_path;
+
+	while (true) {
+		const auto opt = getopt_long(argc, argv, short_opts, long_opts, nullptr);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'i':
+			input_file_names.push_back(optarg);
+			break;
+		case 's':
+			socket_path = optarg;
+			break;
+		case 't':
+			threads = std::atoi(optarg);
+			break;
+		case 'h':
+		case '?':
+		default:
+			std::cout << help << std::endl;
+			return 0;
+		}
+	}
+
+	if (input_file_names.empty()) {
+		std::cerr << "Error: input file not provided" << std::endl;
+		return 0;
+	}
+
+	if (socket_path.empty()) {
+		std::cerr << "Error: socket path not provided" << std::endl;
+		return 0;
+	}
+
+	graph_server server;
+
+	for (const std::string& name : input_file_names) {
+		if (add_graph(server, name, threads) == false)
+			return 0;
+
+		const csr_graph& c = server.graphs.back()->graph;
+		std::cerr << "graph " << server.graphs.size() - 1 << ": " << name << ", "
+			<< c.max_index + 1 << " vertices" << std::endl;
+	}
+
+	// signals are blocked before threads start, so only sigwait below receives them
+	sigset_t signals;
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGINT);
+	sigaddset(&signals, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+	if (start_server(server, socket_path, threads) == false)
+		return 0;
+
+	std::cerr << "listening on " << socket_path << std::endl;
+
+	int signal = 0;
+	sigwait(&signals, &signal);
+
+	stop_server(server);
+	print_server_latency(server, std::cout);
+
+	return 0;
+}
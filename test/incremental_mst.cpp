@@ -0,0 +1,176 @@
+/**
+ * @file incremental_mst.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a main function of a tool that checks incremental maximum spanning forests
+ */
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <getopt.h>
+#include <random>
+#include <string>
+#include "../include/graph.h"
+#include "../include/csr_graph.h"
+#include "../include/spanning_tree.h"
+#include "../include/spanning_forest.h"
+#include "../include/incremental_mst.h"
+
+std::string help =
+R"(Insert random edges into the provided input graph, keep its maximum spanning forest up to date
+and check it against a maximum spanning forest calculated from scratch
+Usage: incrementalmst [OPTION]...
+Program options:
+--input -i=<val>:            input file containg the graph description.
+--output -o=<val>:           output file containg the maximum spanning forest after all insertions.
+--updates -u=<val>:          number of inserted edges, 1000 by default.
+--batch -b=<val>:            number of edges inserted at once, 64 by default.
+--seed -s=<val>:             seed of inserted edges, 1 by default.
+--help -h:                   show help
+)";
+
+/**
+ * Counts edges of a spanning forest
+ * @param data: contains a spanning forest
+ * @return number of vertices that have a parent
+ */
+static size_t forest_edges(const mst_data& data)
+{
+	size_t count = 0;
+
+	for (int p : data.parent)
+		count += p != -1;
+
+	return count;
+}
+
+/**
+ * Main program's function
+ * @param argc: number of command line arguments
+ * @param argv: an array of command line arguments
+ * @return return zero on program's exit
+ */
+int main(int argc, char** argv)
+{
+	if (argc == 1) {
+		std::cerr << help;
+		return 0;
+	}
+
+	const char* const short_opts = "i:o:u:b:s:h";
+
+	const option long_opts[] = {
+		{"input", required_argument, nullptr, 'i'},
+		{"output", required_argument, nullptr, 'o'},
+		{"updates", required_argument, nullptr, 'u'},
+		{"batch", required_argument, nullptr, 'b'},
+		{"seed", required_argument, nullptr, 's'},
+		{"help", no_argument, nullptr, 'h'},
+		{nullptr, no_argument, nullptr, 0}
+	};
+
+	bool has_ifile = false;
+	bool has_ofile = false;
+	int updates = 1000;
+	int batch = 64;
+	unsigned seed = 1;
+	std::string input_file_name;
+	std::string output_file_name;
+
+	while (true) {
+		const auto opt = getopt_long(argc, argv, short_opts, long_opts, nullptr);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'i':
+			input_file_name = optarg;
+			has_ifile = true;
+			break;
+		case 'o':
+			output_file_name = optarg;
+			has_ofile = true;
+			break;
+		case 'u':
+			updates = std::atoi(optarg);
+			break;
+		case 'b':
+			batch = std::max(1, std::atoi(optarg));
+			break;
+		case 's':
+			seed = std::atoi(optarg);
+			break;
+		case 'h':
+		case '?':
+		default:
+			std::cout << help << std::endl;
+			return 0;
+		}
+	}
+
+	if (!has_ifile) {
+		std::cerr << "Error: input file not provided" << std::endl;
+		return 0;
+	}
+
+	if (!has_ofile) {
+		std::cerr << "Error: output file not provided" << std::endl;
+		return 0;
+	}
+
+	graph g;
+
+	if (graph_from_file(input_file_name, g) == false)
+		return 0;
+
+	csr_graph c;
+	freeze_graph(g, c);
+
+	mst_data data(c);
+	maximum_spanning_forest(c, data);
+
+	incremental_mst m(g, data);
+
+	// some inserted edges reach past the last vertex, so the graph grows as well
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> vertex(0, g.max_index + 1 + g.max_index / 10);
+	std::uniform_real_distribution<double> weight(0, 100);
+
+	size_t accepted = 0;
+	std::vector<weighted_edge> edges;
+
+	for (int done = 0; done < updates; done += batch) {
+		edges.clear();
+		for (int i = done; i < updates && i < done + batch; i++)
+			edges.push_back({ vertex(rng), vertex(rng), weight(rng) });
+
+		accepted += insert_edges(m, edges);
+	}
+
+	materialize_forest(m);
+
+	csr_graph final_graph;
+	freeze_graph(g, final_graph);
+
+	mst_data expected(final_graph);
+	maximum_spanning_forest(final_graph, expected);
+
+	double incremental_weight = spanning_tree_weight(data);
+	double expected_weight = spanning_tree_weight(expected);
+
+	std::cout << "inserted edges: " << updates << ", accepted into forest: " << accepted << std::endl;
+	std::cout << "incremental weight: " << incremental_weight
+		<< ", from scratch: " << expected_weight << std::endl;
+
+	if (forest_edges(data) != forest_edges(expected) ||
+		std::fabs(incremental_weight - expected_weight) > 1e-9 * std::max(1.0, std::fabs(expected_weight))) {
+		std::cerr << "Error: incremental forest differs from the one calculated from scratch" << std::endl;
+		return 1;
+	}
+
+	if (print_mst_to_file(data, output_file_name) == false)
+		return 0;
+
+	return 0;
+}
@@ -8,15 +8,31 @@
 #include <getopt.h>
 #include <string>
 #include <iomanip>
+#include <optional>
 #include "../include/graph.h"
+#include "../include/csr_graph.h"
+#include "../include/graph_snapshot.h"
+#include "../include/external_graph.h"
 #include "../include/spanning_tree.h"
+#include "../include/spanning_forest.h"
+#include "../include/connected_components.h"
+#include "../include/reorder.h"
+#include "../include/stats.h"
 
 std::string help =
-R"(Calculate maximum spanning tree of the provided input graph
+R"(Calculate maximum spanning tree of every component of the provided input graph
 Usage: maxspanningtree [OPTION]...
 Program options:
---input -i=<val>:            input file containg the graph description.
---output -o=<val>:           output file containg the maximum spanning tree of the provided input graph.
+--input -i=<val>:            input file containg the graph description or its binary snapshot.
+--output -o=<val>:           output file containg the maximum spanning tree of the provided input graph, - for the standard output.
+--format -f=<val>:           format of the output file, one of: text, binary, text by default.
+--parallel -p:               calculate maximum spanning forest with parallel Boruvka's algorithm instead of Prim's.
+--threads -t=<val>:          number of threads, all hardware threads by default.
+--external -x:               calculate maximum spanning forest with Boruvka's algorithm reading edges of a binary snapshot
+                             from disk in every round instead of loading it.
+--block -b=<val>:            number of bytes of neighbours read at once with --external, 4 MiB by default.
+--reorder -r=<val>:          relabel vertices for locality and span only the component of the first vertex, one of: rcm, degree, bfs.
+--trace -T=<val>:            output file of a Chrome trace of the run, needs a build with GAL_STATS.
 --help -h:                   show help
 )";
 
@@ -33,18 +49,33 @@ int main(int argc, char** argv)
 		return 0;
     }
 
-    const char* const short_opts = "i:s:";
+    const char* const short_opts = "i:o:f:pt:xb:r:T:";
 
     const option long_opts[] = {
         {"input", required_argument, nullptr, 'i'},
 		{"output", required_argument, nullptr, 'o'},
+		{"format", required_argument, nullptr, 'f'},
+		{"parallel", no_argument, nullptr, 'p'},
+		{"threads", required_argument, nullptr, 't'},
+		{"external", no_argument, nullptr, 'x'},
+		{"block", required_argument, nullptr, 'b'},
+		{"reorder", required_argument, nullptr, 'r'},
+		{"trace", required_argument, nullptr, 'T'},
         {nullptr, no_argument, nullptr, 0}
     };
 
 	bool has_ifile = false;
 	bool has_ofile = false;
+	bool parallel = false;
+	int threads = 0;
+	bool external = false;
+	size_t block_bytes = default_external_block;
+	bool reorder = false;
+	vertex_order order = vertex_order::rcm;
+	result_format format = result_format::text;
 	std::string input_file_name;
 	std::string output_file_name;
+	std::string trace_file_name;
 
     while (true) {
         const auto opt = getopt_long(argc, argv, short_opts, long_opts, nullptr);
@@ -60,6 +91,40 @@ int main(int argc, char** argv)
 		case 'o':
 			output_file_name = optarg;
 			has_ofile = true;
+        break;
+		case 'f':
+			if (!parse_result_format(optarg, format)) {
+				std::cerr << "Error: unknown output format: " << optarg << std::endl;
+				return 0;
+			}
+        break;
+		case 'p':
+			parallel = true;
+        break;
+		case 't':
+			threads = std::atoi(optarg);
+        break;
+		case 'x':
+			external = true;
+        break;
+		case 'b':
+			block_bytes = std::strtoull(optarg, nullptr, 10);
+        break;
+		case 'r':
+			reorder = true;
+			if (std::string(optarg) == "rcm") {
+				order = vertex_order::rcm;
+			} else if (std::string(optarg) == "degree") {
+				order = vertex_order::degree;
+			} else if (std::string(optarg) == "bfs") {
+				order = vertex_order::bfs;
+			} else {
+				std::cerr << "Error: unknown vertex order: " << optarg << std::endl;
+				return 0;
+			}
+        break;
+		case 'T':
+			trace_file_name = optarg;
         break;
         case 'h':
         case '?':
@@ -80,14 +145,27 @@ int main(int argc, char** argv)
 		return 0;
     }
 
-	graph g;
+#ifndef GAL_STATS
+	if (!trace_file_name.empty()) {
+		std::cerr << "Error: statistics are not collected without GAL_STATS" << std::endl;
+		return 0;
+	}
+#endif
 
-	if (graph_from_file(input_file_name, g) == false)
+	csr_graph c;
+	external_graph e;
+
+	if (external) {
+		if (open_external_graph(input_file_name, e, block_bytes) == false)
+			return 0;
+	} else if (load_graph(input_file_name, c, threads) == false) {
 		return 0;
+	}
 
 	int start = -1;
-	for (size_t i = 0; i < g.edges.size(); i++) {
-		if (g.edges[i] != nullptr) {
+	int max_index = external ? e.max_index : c.max_index;
+	for (int i = 0; i <= max_index; i++) {
+		if ((external ? degree(e, i) : degree(c, i)) != 0) {
 			start = i;
 			break;
 		}
@@ -97,18 +175,47 @@ int main(int argc, char** argv)
 		std::cerr << "Error: input graph is empty" << std::endl;
 	}
 
-	mst_data data(g);
+	mst_data data = external ? mst_data(e) : mst_data(c);
 
 	if (start == -1) {
 		std::cerr << "Error: input graph is empty" << std::endl;
 	}
 
-	maximum_spanning_tree(g, start, data);
+	// statistics and hardware counters are collected only for a trace
+	bool trace = !trace_file_name.empty();
+	run_stats stats(trace);
+
+	{
+		std::optional<stats_scope> scope;
+		if (trace)
+			scope.emplace(stats);
+
+		if (external) {
+			if (maximum_spanning_forest(e, data) == false)
+				return 0;
+			std::cerr << "read " << e.bytes_read << " bytes in " << e.reads << " reads" << std::endl;
+		} else if (parallel) {
+			maximum_spanning_forest(c, data, threads);
+		} else if (reorder) {
+			reordered_graph r;
+			reorder_graph(c, order, r);
+			maximum_spanning_tree(r, start, data);
+		} else {
+			// components are found first, so none of them is dropped
+			std::vector<int> component;
+			connected_components(c, component, threads);
+			component_spanning_forest(c, component, data, threads);
+		}
+	}
+
+	if (!trace_file_name.empty()) {
+		if (print_stats_trace(stats, trace_file_name) == false)
+			return 0;
+	}
 
-	if (print_mst_to_file(data, output_file_name) == false)
+	if (print_mst_to_file(data, output_file_name, format) == false)
 		return 0;
 
-	free_graph(g);
 	return 0;
 }
 
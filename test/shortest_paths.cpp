@@ -0,0 +1,194 @@
+/**
+ * @file shortest_paths.cpp
+ * @author Jacek Falkowski
+ * @brief File contains implementation of a main function of a tool that calculates shortest paths
+ */
+#include <iostream>
+#include <cstdlib>
+#include <getopt.h>
+#include <string>
+#include <vector>
+#include "../include/csr_graph.h"
+#include "../include/graph_loader.h"
+#include "../include/graph_snapshot.h"
+#include "../include/shortest_paths.h"
+
+std::string help =
+R"(Calculate shortest paths from a source vertex of the provided input graph
+Usage: shortestpaths [OPTION]...
+Program options:
+--input -i=<val>:            input file containg the graph description or its binary snapshot.
+--output -o=<val>:           output file containg the shortest paths as (parent, vertex, distance) triples.
+--source -s=<val>:           source vertex, 0 by default.
+--parallel -p:               calculate shortest paths with parallel delta-stepping instead of Dijkstra's algorithm.
+--threads -t=<val>:          number of threads, all hardware threads by default.
+--delta -d=<val>:            width of a bucket of delta-stepping, chosen from the graph by default.
+--check -c:                  compare distances with Dijkstra's algorithm and with known cases, exit with 1 on a difference.
+--help -h:                   show help
+)";
+
+//! graph, source and bucket width of a case that delta-stepping once got wrong
+struct known_case {
+	std::vector<weighted_edge> edges; //!< edges of a graph
+	int source; //!< source vertex
+	double delta; //!< width of a bucket
+};
+
+//! cases checked by --check besides the input graph
+static const std::vector<known_case> known_cases = {
+	// 1942.1178691630753 / delta rounds up to a bucket that starts past the distance of vertex 2
+	{ { { 0, 1, 1941.1178691630753 }, { 1, 2, 1 } }, 0, 3.4114549545924 },
+};
+
+/**
+ * Compares distances of delta-stepping with those of Dijkstra's algorithm
+ * @param c: graph
+ * @param source: source vertex
+ * @param delta: width of a bucket, 0 chooses it from the graph
+ * @param threads: number of threads of delta-stepping
+ * @return false if a distance differs
+ */
+static bool check_distances(const csr_graph& c, int source, double delta, int threads)
+{
+	sssp_data expected(c);
+	sssp_data actual(c);
+
+	if (!dijkstra(c, source, expected) || !delta_stepping(c, source, actual, delta, threads))
+		return false;
+
+	for (int x = 0; x <= c.max_index; x++) {
+		if (expected.distance[x] != actual.distance[x]) {
+			std::cerr << "Error: distance of vertex " << x << " is " << actual.distance[x]
+				<< ", Dijkstra's algorithm gives " << expected.distance[x] << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Main program's function
+ * @param argc: number of command line arguments
+ * @param argv: an array of command line arguments
+ * @return return zero on program's exit
+ */
+int main(int argc, char** argv)
+{
+	if (argc == 1) {
+		std::cerr << help;
+		return 0;
+	}
+
+	const char* const short_opts = "i:o:s:pt:d:ch";
+
+	const option long_opts[] = {
+		{"input", required_argument, nullptr, 'i'},
+		{"output", required_argument, nullptr, 'o'},
+		{"source", required_argument, nullptr, 's'},
+		{"parallel", no_argument, nullptr, 'p'},
+		{"threads", required_argument, nullptr, 't'},
+		{"delta", required_argument, nullptr, 'd'},
+		{"check", no_argument, nullptr, 'c'},
+		{"help", no_argument, nullptr, 'h'},
+		{nullptr, no_argument, nullptr, 0}
+	};
+
+	bool has_ifile = false;
+	bool has_ofile = false;
+	bool parallel = false;
+	bool check = false;
+	int source = 0;
+	int threads = 0;
+	double delta = 0;
+	std::string input_file_name;
+	std::string output_file_name;
+
+	while (true) {
+		const auto opt = getopt_long(argc, argv, short_opts, long_opts, nullptr);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'i':
+			input_file_name = optarg;
+			has_ifile = true;
+			break;
+		case 'o':
+			output_file_name = optarg;
+			has_ofile = true;
+			break;
+		case 's':
+			source = std::atoi(optarg);
+			break;
+		case 'p':
+			parallel = true;
+			break;
+		case 't':
+			threads = std::atoi(optarg);
+			break;
+		case 'd':
+			delta = std::atof(optarg);
+			break;
+		case 'c':
+			check = true;
+			break;
+		case 'h':
+		case '?':
+		default:
+			std::cout << help << std::endl;
+			return 0;
+		}
+	}
+
+	if (!has_ifile) {
+		std::cerr << "Error: input file not provided" << std::endl;
+		return 0;
+	}
+
+	if (!has_ofile) {
+		std::cerr << "Error: output file not provided" << std::endl;
+		return 0;
+	}
+
+	csr_graph c;
+
+	if (load_graph(input_file_name, c, threads) == false)
+		return 0;
+
+	if (source < 0 || source > c.max_index) {
+		std::cerr << "Error: source vertex is not in the graph" << std::endl;
+		return 0;
+	}
+
+	sssp_data data(c);
+	bool ok;
+
+	if (parallel)
+		ok = delta_stepping(c, source, data, delta, threads);
+	else
+		ok = dijkstra(c, source, data);
+
+	if (!ok)
+		return 0;
+
+	if (print_sssp_to_file(data, output_file_name) == false)
+		return 0;
+
+	if (check) {
+		if (!check_distances(c, source, delta, threads))
+			return 1;
+
+		for (const known_case& k : known_cases) {
+			csr_graph known;
+			csr_from_edges(k.edges, known);
+			if (!check_distances(known, k.source, k.delta, 1))
+				return 1;
+		}
+
+		std::cout << "distances match Dijkstra's algorithm" << std::endl;
+	}
+
+	return 0;
+}